@@ -0,0 +1,112 @@
+// A quiet period, a burst of blocking tasks, then quiet again, run on a fixed pool of MinThreads
+// workers, a fixed pool of MaxThreads workers and an adaptive pool between the two. The tasks sleep
+// like calls that wait on I/O, so extra workers shorten the burst even on few cores. Reports how
+// long each burst took and samples the adaptive pool's size along the way. Checks that the
+// adaptive pool grew during the burst, shrank back to MinThreads after it, and ran every task.
+// Usage: AdaptivePoolBenchmark [tasks=2000] [taskMicroseconds=200] [minThreads=1] [maxThreads=8]
+
+#include "Walrus/EventLoop.h"
+#include "Walrus/Timer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace Walrus;
+
+struct Result {
+    double burstSeconds = 0;
+    size_t peakWorkers = 0;
+    size_t finalWorkers = 0;
+    bool allRan = false;
+    EventLoopStats stats;
+};
+
+static Result RunPhases(const ThreadPoolSpecification& workers, size_t tasks, std::chrono::microseconds taskTime,
+                        std::chrono::milliseconds quiet, bool printSamples) {
+    EventLoopSpecification specification;
+    specification.Workers = workers;
+
+    EventLoop loop(specification);
+    loop.Start();
+    std::this_thread::sleep_for(quiet);
+
+    Result result;
+    std::atomic<size_t> done{0};
+    Timer timer;
+    for (size_t i = 0; i < tasks; ++i) {
+        loop.Post([&done, taskTime]() {
+            std::this_thread::sleep_for(taskTime);
+            done.fetch_add(1);
+        });
+    }
+    while (done.load() < tasks) {
+        result.peakWorkers = std::max(result.peakWorkers, loop.GetStats().Workers);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    result.burstSeconds = timer.Elapsed();
+
+    // An adaptive pool gets three shrink windows per worker to let go, sampled every quarter window
+    const auto sample = std::max(workers.ShrinkWindow / 4, std::chrono::milliseconds(1));
+    const size_t samples = workers.AdaptiveThreads ? 12 * std::max<size_t>(result.peakWorkers, 1) : 0;
+    for (size_t i = 0; i < samples && loop.GetStats().Workers > workers.MinThreads; ++i) {
+        std::this_thread::sleep_for(sample);
+        if (printSamples) {
+            std::cout << "  idle " << std::setw(6) << (i + 1) * sample.count() << " ms: " << loop.GetStats().Workers
+                      << " workers" << std::endl;
+        }
+    }
+
+    result.stats = loop.GetStats();
+    result.finalWorkers = result.stats.Workers;
+    result.allRan = done.load() == tasks;
+    loop.Stop();
+    return result;
+}
+
+int main(int argc, char** argv) {
+    size_t tasks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    auto taskTime = std::chrono::microseconds(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200);
+    size_t minThreads = argc > 3 ? std::max<size_t>(1, std::strtoul(argv[3], nullptr, 10)) : 1;
+    size_t maxThreads = argc > 4 ? std::max<size_t>(minThreads + 1, std::strtoul(argv[4], nullptr, 10)) : 8;
+    const auto quiet = std::chrono::milliseconds(100);
+
+    std::cout << tasks << " tasks of " << taskTime.count() << " us, " << minThreads << " to " << maxThreads
+              << " workers" << std::endl;
+
+    ThreadPoolSpecification fixedMin;
+    fixedMin.ThreadCount = minThreads;
+    ThreadPoolSpecification fixedMax;
+    fixedMax.ThreadCount = maxThreads;
+    ThreadPoolSpecification adaptive;
+    adaptive.ThreadCount = maxThreads;
+    adaptive.AdaptiveThreads = true;
+    adaptive.MinThreads = minThreads;
+    adaptive.MaxThreads = maxThreads;
+    adaptive.GrowWait = std::chrono::microseconds(500);
+    adaptive.ShrinkWindow = std::chrono::milliseconds(100);
+
+    Result small = RunPhases(fixedMin, tasks, taskTime, quiet, false);
+    Result large = RunPhases(fixedMax, tasks, taskTime, quiet, false);
+    std::cout << "Adaptive pool after the burst:" << std::endl;
+    Result scaled = RunPhases(adaptive, tasks, taskTime, quiet, true);
+
+    auto report = [](const char* name, const Result& result) {
+        std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << result.burstSeconds * 1e3 << " ms burst, peak " << result.peakWorkers
+                  << ", after " << result.finalWorkers << " workers" << std::endl;
+    };
+    report("Fixed min", small);
+    report("Fixed max", large);
+    report("Adaptive", scaled);
+    std::cout << "Adaptive pool added " << scaled.stats.WorkersAdded << " and retired " << scaled.stats.WorkersRetired
+              << " workers" << std::endl;
+
+    bool correct = small.allRan && large.allRan && scaled.allRan && scaled.peakWorkers > minThreads &&
+                   scaled.finalWorkers == minThreads;
+    std::cout << (correct ? "PASS: the pool grew for the burst and shrank back afterwards" : "FAIL: see above") << std::endl;
+    return correct ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+// A producer floods a slow pool with Post under each overflow policy of a bounded task queue, then
+// with no limit for comparison. Every task owns a token that lives until the task has run or been
+// dropped, so the peak token count is the memory the backlog held. Reports the peak, the submit
+// rate and the outcome counters, and checks that the peak stayed near the capacity and that every
+// task was either run, dropped or rejected. A burst of timeouts checks the timer limit the same way.
+// Usage: BackpressureBenchmark [tasks=200000] [capacity=1024] [work=200]
+
+#include "Walrus/EventLoop.h"
+#include "Walrus/Timer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+using namespace Walrus;
+
+static std::atomic<int64_t> s_Live{0};
+static std::atomic<int64_t> s_Ran{0};
+
+// Stands for the data a queued task holds on to
+struct Token {
+    Token() { s_Live.fetch_add(1, std::memory_order_relaxed); }
+    ~Token() { s_Live.fetch_sub(1, std::memory_order_relaxed); }
+};
+
+static uint64_t Compute(uint64_t value, int work) {
+    for (int i = 0; i < work; ++i) {
+        value = value * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    return value;
+}
+
+static const char* PolicyName(OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::Block: return "Block";
+        case OverflowPolicy::Reject: return "Reject";
+        case OverflowPolicy::RunInCaller: return "RunInCaller";
+        case OverflowPolicy::DropOldest: return "DropOldest";
+    }
+    return "?";
+}
+
+// Returns false if a check failed; capacity 0 runs unbounded
+static bool RunPolicy(size_t tasks, size_t capacity, OverflowPolicy policy, int work) {
+    EventLoopSpecification specification;
+    specification.Workers.ThreadCount = 2;
+    specification.TaskLimit.Capacity = capacity;
+    specification.TaskLimit.Policy = policy;
+
+    EventLoop loop(specification);
+    loop.Start();
+    s_Ran.store(0);
+
+    std::atomic<uint64_t> sink{0};
+    int64_t peak = 0;
+    Timer timer;
+    for (size_t i = 0; i < tasks; ++i) {
+        loop.Post([token = std::make_unique<Token>(), &sink, work, i]() {
+            sink.fetch_add(Compute(i, work), std::memory_order_relaxed);
+            s_Ran.fetch_add(1, std::memory_order_relaxed);
+        });
+        peak = std::max(peak, s_Live.load(std::memory_order_relaxed));
+    }
+    double submitRate = tasks / timer.Elapsed();
+
+    while (s_Live.load() != 0) {
+        std::this_thread::yield();
+    }
+    OverflowStats overflow = loop.GetStats().TaskOverflow;
+    loop.Stop();
+
+    const uint64_t ran = static_cast<uint64_t>(s_Ran.load());
+    bool accounted = ran + overflow.Rejected + overflow.DroppedOldest == tasks;
+    // Room for the tasks running on the workers and a drop in flight
+    bool bounded = capacity == 0 || peak <= static_cast<int64_t>(capacity + specification.Workers.ThreadCount + 2);
+
+    std::cout << std::left << std::setw(13) << (capacity == 0 ? "Unbounded" : PolicyName(policy)) << std::right
+              << std::setw(10) << peak
+              << std::setw(12) << std::fixed << std::setprecision(0) << submitRate
+              << std::setw(9) << ran
+              << std::setw(9) << overflow.Blocked
+              << std::setw(9) << overflow.Rejected
+              << std::setw(9) << overflow.RanInCaller
+              << std::setw(9) << overflow.DroppedOldest
+              << ((accounted && bounded) ? "" : "  <- check failed") << std::endl;
+    return accounted && bounded;
+}
+
+static bool RunTimerLimit(size_t capacity) {
+    EventLoopSpecification specification;
+    specification.TimerLimit.Capacity = capacity;
+
+    EventLoop loop(specification);
+    loop.Start();
+
+    std::atomic<size_t> fired{0};
+    size_t armed = 0;
+    for (size_t i = 0; i < capacity * 4; ++i) {
+        armed += loop.SetTimeout([&fired]() { fired.fetch_add(1); }, std::chrono::milliseconds(20)) != 0 ? 1 : 0;
+    }
+    while (fired.load() < armed) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    OverflowStats overflow = loop.GetStats().TimerOverflow;
+    loop.Stop();
+
+    bool correct = armed == capacity && overflow.Rejected == capacity * 3;
+    std::cout << "Timers: " << armed << " of " << capacity * 4 << " armed under a limit of " << capacity << ", "
+              << overflow.Rejected << " rejected" << std::endl;
+    return correct;
+}
+
+int main(int argc, char** argv) {
+    size_t tasks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    size_t capacity = argc > 2 ? std::max<size_t>(1, std::strtoul(argv[2], nullptr, 10)) : 1024;
+    int work = argc > 3 ? std::max(0, std::atoi(argv[3])) : 200;
+
+    std::cout << tasks << " tasks, capacity " << capacity << ", " << work << " steps per task, 2 workers" << std::endl;
+    std::cout << std::left << std::setw(13) << "Policy" << std::right
+              << std::setw(10) << "Peak"
+              << std::setw(12) << "Submit/s"
+              << std::setw(9) << "Ran"
+              << std::setw(9) << "Blocked"
+              << std::setw(9) << "Rejected"
+              << std::setw(9) << "InCaller"
+              << std::setw(9) << "Dropped" << std::endl;
+
+    bool correct = RunPolicy(tasks, 0, OverflowPolicy::Reject, work);
+    for (OverflowPolicy policy : { OverflowPolicy::Block, OverflowPolicy::Reject, OverflowPolicy::RunInCaller,
+                                   OverflowPolicy::DropOldest }) {
+        correct = RunPolicy(tasks, capacity, policy, work) && correct;
+    }
+    correct = RunTimerLimit(capacity) && correct;
+
+    std::cout << (correct ? "PASS: backlog stayed bounded and every task is accounted for" : "FAIL: see above") << std::endl;
+    return correct ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+// Cost of submitting a frame's worth of small tasks one by one versus through the batch APIs
+// (SetImmediateBatch, PostBulk, SetTimeoutBatch), measured on the submitting thread.
+// Usage: BatchSubmissionBenchmark [tasks=10000] [rounds=50]
+
+#include "Walrus/EventLoop.h"
+#include "Walrus/Timer.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace Walrus;
+
+enum class Api { Immediate, Post, Timeout };
+
+static const char* ApiName(Api api) {
+    switch (api) {
+        case Api::Immediate: return "SetImmediate";
+        case Api::Post:      return "Post        ";
+        case Api::Timeout:   return "SetTimeout  ";
+    }
+    return "";
+}
+
+// Average nanoseconds per task spent by the submitting thread
+static double Submit(EventLoop& loop, Api api, bool batch, size_t tasks, int rounds) {
+    std::atomic<uint64_t> ran{0};
+    std::vector<EventCallback> callbacks;
+    std::vector<TimerRequest> timers;
+    std::vector<EventId> ids;
+    callbacks.reserve(tasks);
+    timers.reserve(tasks);
+    ids.reserve(tasks);
+
+    double elapsed = 0.0;
+    for (int round = 0; round < rounds; ++round) {
+        const uint64_t expected = ran.load() + tasks;
+
+        if (batch) {
+            // Building the batch is part of the caller's work too
+            Timer timer;
+            for (size_t i = 0; i < tasks; ++i) {
+                auto callback = [&ran]() { ran.fetch_add(1, std::memory_order_relaxed); };
+                if (api == Api::Timeout) {
+                    timers.push_back({ callback, std::chrono::microseconds(100), TimerSpecification() });
+                } else {
+                    callbacks.push_back(callback);
+                }
+            }
+            switch (api) {
+                case Api::Immediate: loop.SetImmediateBatch(callbacks, &ids); break;
+                case Api::Post:      loop.PostBulk(callbacks); break;
+                case Api::Timeout:   loop.SetTimeoutBatch(timers, &ids); break;
+            }
+            elapsed += timer.Elapsed();
+        } else {
+            Timer timer;
+            for (size_t i = 0; i < tasks; ++i) {
+                auto callback = [&ran]() { ran.fetch_add(1, std::memory_order_relaxed); };
+                switch (api) {
+                    case Api::Immediate: loop.SetImmediate(callback); break;
+                    case Api::Post:      loop.Post(callback); break;
+                    case Api::Timeout:   loop.SetTimeout(callback, std::chrono::microseconds(100)); break;
+                }
+            }
+            elapsed += timer.Elapsed();
+        }
+
+        while (ran.load() < expected) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+    return elapsed * 1e9 / (static_cast<double>(tasks) * rounds);
+}
+
+int main(int argc, char** argv) {
+    size_t tasks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    EventLoop loop;
+    loop.Start();
+
+    std::cout << "Submitting " << tasks << " tasks per round, " << rounds << " rounds" << std::endl;
+    std::cout << std::left << std::setw(14) << "API" << std::right
+              << std::setw(16) << "Single ns/task"
+              << std::setw(16) << "Batch ns/task"
+              << std::setw(10) << "Speedup" << std::endl;
+
+    for (Api api : { Api::Immediate, Api::Post, Api::Timeout }) {
+        double single = Submit(loop, api, false, tasks, rounds);
+        double batch = Submit(loop, api, true, tasks, rounds);
+
+        std::cout << std::left << std::setw(14) << ApiName(api) << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(16) << single
+                  << std::setw(16) << batch
+                  << std::setprecision(2) << std::setw(9) << single / batch << "x" << std::endl;
+    }
+
+    loop.Stop();
+    return 0;
+}
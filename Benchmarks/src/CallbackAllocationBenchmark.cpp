@@ -0,0 +1,160 @@
+// Heap allocations per fired interval tick and per scheduled event, counted by replacing the
+// global operator new. Callbacks with small captures must fire and be scheduled without
+// allocating once the pools are warm; the process exits with 1 otherwise.
+// Usage: CallbackAllocationBenchmark [ticks=500]
+
+#include "Walrus/EventLoop.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <thread>
+
+namespace {
+
+    std::atomic<uint64_t> g_Allocations{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    g_Allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+using namespace Walrus;
+
+struct Capture {
+    void* Context[4];
+    uint64_t Value;
+};
+
+template<typename Function>
+static double AllocationsPerCall(int calls) {
+    Capture capture{};
+    std::atomic<uint64_t> sink{0};
+
+    uint64_t before = g_Allocations.load();
+    for (int i = 0; i < calls; ++i) {
+        Function function = [capture, &sink]() { sink.fetch_add(capture.Value + 1, std::memory_order_relaxed); };
+        Function moved = std::move(function);
+        moved();
+    }
+    return static_cast<double>(g_Allocations.load() - before) / calls;
+}
+
+static double AllocationsPerTick(TimerBackend backend, bool countedCallback, uint64_t ticks) {
+    EventLoop loop(backend);
+    loop.Start();
+
+    Capture capture{};
+    std::atomic<uint64_t> fired{0};
+
+    EventId id;
+    if (countedCallback) {
+        TimerSpecification specification;
+        specification.Policy = IntervalPolicy::Coalesce;
+        id = loop.SetInterval([capture, &fired](uint64_t missedTicks) {
+            fired.fetch_add(1 + missedTicks + capture.Value, std::memory_order_relaxed);
+        }, std::chrono::microseconds(200), specification);
+    } else {
+        id = loop.SetInterval([capture, &fired]() {
+            fired.fetch_add(1 + capture.Value, std::memory_order_relaxed);
+        }, std::chrono::microseconds(200));
+    }
+
+    auto waitFor = [&fired](uint64_t count) {
+        while (fired.load() < count) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+
+    // Warm up so the reusable buffers of the loop and the pool have reached their size
+    waitFor(50);
+
+    uint64_t allocationsBefore = g_Allocations.load();
+    uint64_t firedBefore = fired.load();
+    waitFor(firedBefore + ticks);
+    uint64_t allocations = g_Allocations.load() - allocationsBefore;
+    uint64_t count = fired.load() - firedBefore;
+
+    loop.ClearInterval(id);
+    loop.Stop();
+    return static_cast<double>(allocations) / count;
+}
+
+static double AllocationsPerScheduledEvent(bool immediate, int events) {
+    EventLoop loop;
+    loop.Start();
+
+    Capture capture{};
+    std::atomic<int> ran{0};
+    const int batch = 100;
+
+    auto runBatch = [&]() {
+        EventId ids[batch];
+        for (int i = 0; i < batch; ++i) {
+            auto callback = [capture, &ran]() { ran.fetch_add(1 + static_cast<int>(capture.Value)); };
+            ids[i] = immediate ? loop.SetImmediate(callback) : loop.SetTimeout(callback, 60000);
+        }
+        // Immediates: every other one is cancelled and the rest run. Timeouts: all are cancelled.
+        for (int i = 0; i < batch; ++i) {
+            if (!immediate || i % 2 == 0) {
+                loop.ClearTimeout(ids[i]);
+            }
+        }
+        // Let the loop drain the batch so the pools stay within their initial capacity
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    };
+
+    runBatch(); // Warm up
+
+    uint64_t before = g_Allocations.load();
+    for (int scheduled = 0; scheduled < events; scheduled += batch) {
+        runBatch();
+    }
+    uint64_t allocations = g_Allocations.load() - before;
+
+    loop.Stop();
+    return static_cast<double>(allocations) / events;
+}
+
+int main(int argc, char** argv) {
+    uint64_t ticks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Capture size: " << sizeof(Capture) + sizeof(void*) << " bytes" << std::endl;
+    std::cout << "std::function construct+move+call: " << AllocationsPerCall<std::function<void()>>(10000) << " allocations" << std::endl;
+    std::cout << "EventCallback construct+move+call: " << AllocationsPerCall<EventCallback>(10000) << " allocations" << std::endl;
+
+    bool allocationFree = true;
+    for (TimerBackend backend : { TimerBackend::Heap, TimerBackend::Wheel }) {
+        for (bool countedCallback : { false, true }) {
+            double perTick = AllocationsPerTick(backend, countedCallback, ticks);
+            allocationFree = allocationFree && perTick == 0.0;
+
+            std::cout << (backend == TimerBackend::Wheel ? "Wheel" : "Heap ")
+                      << (countedCallback ? " IntervalCallback" : " EventCallback   ")
+                      << ": " << perTick << " allocations per tick" << std::endl;
+        }
+    }
+
+    for (bool immediate : { true, false }) {
+        double perEvent = AllocationsPerScheduledEvent(immediate, 10000);
+        allocationFree = allocationFree && perEvent == 0.0;
+
+        std::cout << (immediate ? "SetImmediate + ClearTimeout" : "SetTimeout + ClearTimeout  ")
+                  << ": " << perEvent << " allocations per event" << std::endl;
+    }
+
+    std::cout << (allocationFree ? "PASS: firing and scheduling are allocation-free" : "FAIL: firing or scheduling allocates") << std::endl;
+    return allocationFree ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+// Many concurrent request workflows written as coroutines versus nested callbacks. Each workflow
+// hops onto the pool, waits a short delay, runs two computation stages and produces a value: as a
+// coroutine with co_await Schedule/Delay/Submit, or as Post -> SetTimeout -> Submit().Then().
+// Both drivers start every workflow at once and gather the results with WhenAll; the checksums
+// must match. Built only with -DWALRUS_ENABLE_COROUTINES=ON.
+// Usage: CoroutineBenchmark [workflows=100000] [delay_ms=1] [work=200]
+
+#include "Walrus/Coroutine.h"
+#include "Walrus/Timer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace Walrus;
+
+// Stand-in for a short computation: work steps of a linear congruential generator
+static uint64_t Stage(uint64_t value, int work) {
+    for (int i = 0; i < work; ++i) {
+        value = value * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    return value;
+}
+
+static Future<uint64_t> CoroutineWorkflow(EventLoop& loop, uint64_t seed, std::chrono::milliseconds delay, int work) {
+    co_await loop.Schedule();
+    co_await loop.Delay(delay);
+    uint64_t a = co_await loop.Submit([seed, work]() { return Stage(seed, work); });
+    co_return Stage(a, work);
+}
+
+static Future<uint64_t> CallbackWorkflow(EventLoop& loop, uint64_t seed, std::chrono::milliseconds delay, int work) {
+    auto promise = std::make_shared<Promise<uint64_t>>(loop);
+    Future<uint64_t> result = promise->GetFuture();
+
+    loop.Post([&loop, promise, seed, delay, work]() {
+        loop.SetTimeout([&loop, promise, seed, work]() {
+            loop.Submit([seed, work]() { return Stage(seed, work); })
+                .Then([promise, work](uint64_t a) { promise->SetValue(Stage(a, work)); });
+        }, delay);
+    });
+    return result;
+}
+
+static uint64_t Checksum(std::vector<uint64_t> values) {
+    uint64_t checksum = 0;
+    for (uint64_t value : values) {
+        checksum ^= value;
+    }
+    return checksum;
+}
+
+// Workflows per second from the first start until the last result
+template<typename Workflow>
+static double Run(EventLoop& loop, Workflow workflow, size_t workflows, std::chrono::milliseconds delay, int work,
+                  uint64_t& checksum) {
+    Timer timer;
+    std::vector<Future<uint64_t>> results;
+    results.reserve(workflows);
+    for (size_t i = 0; i < workflows; ++i) {
+        results.push_back(workflow(loop, i, delay, work));
+    }
+    checksum = Checksum(WhenAll(std::move(results)).Get());
+    return workflows / timer.Elapsed();
+}
+
+int main(int argc, char** argv) {
+    size_t workflows = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    std::chrono::milliseconds delay(argc > 2 ? std::max(0, std::atoi(argv[2])) : 1);
+    int work = argc > 3 ? std::max(0, std::atoi(argv[3])) : 200;
+
+    EventLoop loop;
+    loop.Start();
+
+    std::cout << workflows << " concurrent workflows, " << delay.count() << " ms delay, "
+              << work << " steps per stage" << std::endl;
+
+    uint64_t callbackChecksum = 0;
+    uint64_t coroutineChecksum = 0;
+    double callbacks = Run(loop, CallbackWorkflow, workflows, delay, work, callbackChecksum);
+    double coroutines = Run(loop, CoroutineWorkflow, workflows, delay, work, coroutineChecksum);
+
+    std::cout << std::left << std::setw(12) << "Callbacks" << std::right << std::fixed << std::setprecision(0)
+              << std::setw(14) << callbacks << " workflows/s" << std::endl;
+    std::cout << std::left << std::setw(12) << "Coroutines" << std::right
+              << std::setw(14) << coroutines << " workflows/s" << std::endl;
+
+    loop.Stop();
+
+    bool correct = callbackChecksum == coroutineChecksum;
+    std::cout << (correct ? "PASS: both drivers produced the same results" : "FAIL: results differ") << std::endl;
+    return correct ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+// Deadline misses of a saturated pool, FIFO versus earliest-deadline-first. Each round submits a
+// burst of equally long tasks whose deadlines are shuffled relative to submission order and just
+// feasible if the pool runs them in deadline order. FIFO uses Post, EDF uses PostWithDeadline.
+// Usage: DeadlineSchedulingBenchmark [tasks=200] [work_us=200] [rounds=10]
+
+#include "Walrus/EventLoop.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace Walrus;
+
+static void BusyWait(std::chrono::microseconds duration) {
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+struct Result {
+    uint64_t Missed = 0;
+    double MaxLatenessMs = 0;
+};
+
+static Result Run(EventLoop& loop, bool edf, size_t tasks, int workUs, int rounds) {
+    const size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1); // Cores, not workers
+    std::mt19937 random(42);
+    std::atomic<uint64_t> missed{0};
+    std::atomic<int64_t> maxLateness{0};
+    std::atomic<size_t> done{0};
+
+    for (int round = 0; round < rounds; ++round) {
+        // Task i gets the i-th slot of a schedule that keeps every worker busy, plus 50% slack
+        std::vector<size_t> slots(tasks);
+        std::iota(slots.begin(), slots.end(), 0);
+        std::shuffle(slots.begin(), slots.end(), random);
+
+        const auto start = std::chrono::steady_clock::now();
+        const size_t expected = done.load() + tasks;
+        for (size_t i = 0; i < tasks; ++i) {
+            const auto deadline = start + std::chrono::microseconds(workUs) * ((slots[i] / threads + 1) * 3 / 2 + 1);
+            auto task = [&, deadline, workUs]() {
+                BusyWait(std::chrono::microseconds(workUs));
+                const int64_t lateness = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - deadline).count();
+                if (lateness > 0) {
+                    missed.fetch_add(1);
+                    int64_t seen = maxLateness.load();
+                    while (lateness > seen && !maxLateness.compare_exchange_weak(seen, lateness)) {
+                    }
+                }
+                done.fetch_add(1);
+            };
+
+            if (edf) {
+                loop.PostWithDeadline(task, deadline);
+            } else {
+                loop.Post(task);
+            }
+        }
+
+        while (done.load() < expected) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    Result result;
+    result.Missed = missed.load();
+    result.MaxLatenessMs = maxLateness.load() / 1e6;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    size_t tasks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200;
+    int workUs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 200;
+    int rounds = argc > 3 ? std::max(1, std::atoi(argv[3])) : 10;
+
+    EventLoop loop;
+    loop.Start();
+
+    std::cout << rounds << " bursts of " << tasks << " tasks, " << workUs << " us each" << std::endl;
+    std::cout << std::left << std::setw(8) << "Mode" << std::right
+              << std::setw(12) << "Missed"
+              << std::setw(12) << "Miss %"
+              << std::setw(20) << "Max lateness ms" << std::endl;
+
+    for (bool edf : { false, true }) {
+        Result result = Run(loop, edf, tasks, workUs, rounds);
+        std::cout << std::left << std::setw(8) << (edf ? "EDF" : "FIFO") << std::right << std::fixed
+                  << std::setw(12) << result.Missed
+                  << std::setprecision(1) << std::setw(12) << 100.0 * result.Missed / (tasks * rounds)
+                  << std::setprecision(3) << std::setw(20) << result.MaxLatenessMs << std::endl;
+    }
+
+    EventLoopStats stats = loop.GetStats();
+    std::cout << "EventLoopStats: " << stats.DeadlineTasks << " deadline tasks, " << stats.DeadlineMisses
+              << " missed, max lateness " << stats.MaxDeadlineLateness.count() / 1e6 << " ms" << std::endl;
+
+    loop.Stop();
+    return 0;
+}
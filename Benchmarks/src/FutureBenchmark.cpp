@@ -0,0 +1,82 @@
+// Three-stage request pipeline, driven by blocking waits versus Future continuations. The
+// blocking driver submits a stage, waits for it with Get() and submits the next, so only one
+// stage is in flight. The continuation driver chains the stages with Then() and gathers all
+// requests with WhenAll, so no thread waits and every request is in flight at once.
+// Usage: FutureBenchmark [requests=20000] [work=20000]
+
+#include "Walrus/Future.h"
+#include "Walrus/Timer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace Walrus;
+
+// Stand-in for a short computation: work steps of a linear congruential generator
+static uint64_t Stage(uint64_t value, int work) {
+    for (int i = 0; i < work; ++i) {
+        value = value * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    return value;
+}
+
+static uint64_t Blocking(EventLoop& loop, size_t requests, int work) {
+    uint64_t checksum = 0;
+    for (size_t i = 0; i < requests; ++i) {
+        uint64_t a = loop.Submit([i, work]() { return Stage(i, work); }).Get();
+        uint64_t b = loop.Submit([a, work]() { return Stage(a, work); }).Get();
+        checksum ^= loop.Submit([b, work]() { return Stage(b, work); }).Get();
+    }
+    return checksum;
+}
+
+static uint64_t Continuations(EventLoop& loop, size_t requests, int work) {
+    std::vector<Future<uint64_t>> results;
+    results.reserve(requests);
+    for (size_t i = 0; i < requests; ++i) {
+        results.push_back(loop.Submit([i, work]() { return Stage(i, work); })
+                              .Then([work](uint64_t a) { return Stage(a, work); })
+                              .Then([work](uint64_t b) { return Stage(b, work); }));
+    }
+
+    return WhenAll(std::move(results)).Then([](std::vector<uint64_t> values) {
+        uint64_t checksum = 0;
+        for (uint64_t value : values) {
+            checksum ^= value;
+        }
+        return checksum;
+    }).Get();
+}
+
+int main(int argc, char** argv) {
+    size_t requests = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    int work = argc > 2 ? std::max(0, std::atoi(argv[2])) : 20000;
+
+    EventLoop loop;
+    loop.Start();
+
+    std::cout << requests << " requests of 3 stages, " << work << " steps per stage" << std::endl;
+    std::cout << std::left << std::setw(16) << "Driver" << std::right
+              << std::setw(16) << "Requests/s" << std::endl;
+
+    Timer timer;
+    uint64_t blocking = Blocking(loop, requests, work);
+    double blockingRate = requests / timer.Elapsed();
+
+    timer.Reset();
+    uint64_t continuations = Continuations(loop, requests, work);
+    double continuationRate = requests / timer.Elapsed();
+
+    std::cout << std::left << std::setw(16) << "Blocking Get" << std::right << std::fixed << std::setprecision(0)
+              << std::setw(16) << blockingRate << std::endl;
+    std::cout << std::left << std::setw(16) << "Then/WhenAll" << std::right
+              << std::setw(16) << continuationRate << std::endl;
+
+    loop.Stop();
+    const bool correct = blocking == continuations;
+    std::cout << (correct ? "PASS: both drivers computed the same results" : "FAIL: results differ") << std::endl;
+    return correct ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+// Interval pile-up under load. A 1 ms interval whose callback takes 5 ms is run with and without
+// TimerSpecification::NonOverlapping; the table shows how many ticks ran at the same time, how
+// many ran in total and how many fires the non-overlapping mode dropped.
+// Usage: IntervalOverloadBenchmark [seconds=2] [work_ms=5]
+
+#include "Walrus/EventLoop.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace Walrus;
+
+struct Result {
+    uint32_t MaxConcurrent = 0;
+    uint64_t Ticks = 0;
+    uint64_t Skipped = 0;
+};
+
+static Result Run(bool nonOverlapping, double seconds, int workMs) {
+    EventLoop loop;
+    loop.Start();
+
+    std::atomic<uint32_t> running{0};
+    std::atomic<uint32_t> maxRunning{0};
+    std::atomic<uint64_t> ticks{0};
+
+    TimerSpecification spec;
+    spec.Policy = IntervalPolicy::CatchUp;
+    spec.NonOverlapping = nonOverlapping;
+
+    EventId id = loop.SetInterval([&]() {
+        const uint32_t now = running.fetch_add(1) + 1;
+        uint32_t seen = maxRunning.load();
+        while (now > seen && !maxRunning.compare_exchange_weak(seen, now)) {
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(workMs));
+        ticks.fetch_add(1);
+        running.fetch_sub(1);
+    }, 1, spec);
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    loop.ClearInterval(id);
+    loop.Stop();
+
+    Result result;
+    result.MaxConcurrent = maxRunning.load();
+    result.Ticks = ticks.load();
+    result.Skipped = loop.GetStats().SkippedIntervalFires;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 2.0;
+    int workMs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+
+    std::cout << "1 ms interval, " << workMs << " ms callback, " << seconds << " s per run" << std::endl;
+    std::cout << std::left << std::setw(16) << "Mode" << std::right
+              << std::setw(16) << "Max concurrent"
+              << std::setw(10) << "Ticks"
+              << std::setw(16) << "Skipped fires" << std::endl;
+
+    bool correct = true;
+    for (bool nonOverlapping : { false, true }) {
+        Result result = Run(nonOverlapping, seconds, workMs);
+        if (nonOverlapping) {
+            correct = result.MaxConcurrent <= 1;
+        }
+
+        std::cout << std::left << std::setw(16) << (nonOverlapping ? "NonOverlapping" : "Default") << std::right
+                  << std::setw(16) << result.MaxConcurrent
+                  << std::setw(10) << result.Ticks
+                  << std::setw(16) << result.Skipped << std::endl;
+    }
+
+    std::cout << (correct ? "PASS: non-overlapping ticks never ran concurrently" : "FAIL: non-overlapping ticks overlapped") << std::endl;
+    return correct ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+// Data-parallel algorithms on the EventLoop pool (Parallel.h) versus serial loops, and versus
+// std::execution::par when the standard library's parallel backend is available (TBB for
+// libstdc++). Every parallel result is checked against the serial one.
+// Usage: ParallelBenchmark [elements=4000000] [rounds=5]
+
+#include "Walrus/Parallel.h"
+#include "Walrus/Timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#if WALRUS_BENCHMARK_STD_PAR
+#include <execution>
+#endif
+
+using namespace Walrus;
+
+static bool s_Correct = true;
+
+// Average seconds per call of function over rounds calls
+template<typename Function>
+static double Measure(int rounds, Function&& function) {
+    Timer timer;
+    for (int i = 0; i < rounds; ++i) {
+        function();
+    }
+    return timer.Elapsed() / rounds;
+}
+
+static void Report(const char* name, double serial, double walrus, double standard) {
+    std::cout << std::left << std::setw(18) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << serial * 1e3
+              << std::setw(12) << walrus * 1e3;
+    if (standard > 0.0) {
+        std::cout << std::setw(14) << standard * 1e3;
+    } else {
+        std::cout << std::setw(14) << "n/a";
+    }
+    std::cout << std::setw(9) << serial / walrus << "x" << std::endl;
+}
+
+static void Check(bool condition, const char* name) {
+    if (!condition) {
+        std::cout << "Mismatch in " << name << std::endl;
+        s_Correct = false;
+    }
+}
+
+// Integer inputs keep every result exact, so parallel and serial must agree bit for bit
+static uint64_t Mix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    return value;
+}
+
+int main(int argc, char** argv) {
+    size_t elements = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4000000;
+    int rounds = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+
+    EventLoop loop;
+    loop.Start();
+
+    std::vector<uint64_t> input(elements);
+    for (size_t i = 0; i < elements; ++i) {
+        input[i] = Mix(i) % 1000;
+    }
+    std::vector<uint64_t> serialOut(elements), walrusOut(elements), standardOut(elements);
+
+    std::cout << elements << " elements, " << loop.GetWorkerCount() << " workers + caller, " << rounds << " rounds" << std::endl;
+    std::cout << std::left << std::setw(18) << "Algorithm" << std::right
+              << std::setw(12) << "Serial ms"
+              << std::setw(12) << "Walrus ms"
+              << std::setw(14) << "std::par ms"
+              << std::setw(10) << "Speedup" << std::endl;
+
+    // For: a few dependent steps per element
+    {
+        auto body = [&](std::vector<uint64_t>& out, size_t i) { out[i] = Mix(Mix(input[i]) + i); };
+        double serial = Measure(rounds, [&]() {
+            for (size_t i = 0; i < elements; ++i) {
+                body(serialOut, i);
+            }
+        });
+        double walrus = Measure(rounds, [&]() {
+            ParallelFor(loop, 0, elements, [&](size_t i) { body(walrusOut, i); });
+        });
+        double standard = 0.0;
+#if WALRUS_BENCHMARK_STD_PAR
+        std::vector<size_t> indices(elements);
+        std::iota(indices.begin(), indices.end(), size_t(0));
+        standard = Measure(rounds, [&]() {
+            std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t i) { body(standardOut, i); });
+        });
+#endif
+        Check(serialOut == walrusOut, "ParallelFor");
+        Report("For", serial, walrus, standard);
+    }
+
+    // Reduce
+    {
+        uint64_t serialSum = 0, walrusSum = 0, standardSum = 0;
+        double serial = Measure(rounds, [&]() { serialSum = std::accumulate(input.begin(), input.end(), uint64_t(0)); });
+        double walrus = Measure(rounds, [&]() { walrusSum = ParallelReduce(loop, input.begin(), input.end(), uint64_t(0)); });
+        double standard = 0.0;
+#if WALRUS_BENCHMARK_STD_PAR
+        standard = Measure(rounds, [&]() {
+            standardSum = std::reduce(std::execution::par, input.begin(), input.end(), uint64_t(0));
+        });
+        Check(serialSum == standardSum, "std::reduce");
+#endif
+        Check(serialSum == walrusSum, "ParallelReduce");
+        Report("Reduce", serial, walrus, standard);
+    }
+
+    // Transform-reduce: sum of mixed values
+    {
+        auto transform = [](uint64_t value) { return Mix(value) & 0xffff; };
+        uint64_t serialSum = 0, walrusSum = 0, standardSum = 0;
+        double serial = Measure(rounds, [&]() {
+            serialSum = 0;
+            for (uint64_t value : input) {
+                serialSum += transform(value);
+            }
+        });
+        double walrus = Measure(rounds, [&]() {
+            walrusSum = ParallelTransformReduce(loop, input.begin(), input.end(), uint64_t(0), std::plus<>(), transform);
+        });
+        double standard = 0.0;
+#if WALRUS_BENCHMARK_STD_PAR
+        standard = Measure(rounds, [&]() {
+            standardSum = std::transform_reduce(std::execution::par, input.begin(), input.end(), uint64_t(0),
+                                                std::plus<>(), transform);
+        });
+        Check(serialSum == standardSum, "std::transform_reduce");
+#endif
+        Check(serialSum == walrusSum, "ParallelTransformReduce");
+        Report("Transform-reduce", serial, walrus, standard);
+    }
+
+    // Inclusive scan
+    {
+        double serial = Measure(rounds, [&]() { std::partial_sum(input.begin(), input.end(), serialOut.begin()); });
+        double walrus = Measure(rounds, [&]() {
+            ParallelInclusiveScan(loop, input.begin(), input.end(), walrusOut.begin());
+        });
+        double standard = 0.0;
+#if WALRUS_BENCHMARK_STD_PAR
+        standard = Measure(rounds, [&]() {
+            std::inclusive_scan(std::execution::par, input.begin(), input.end(), standardOut.begin());
+        });
+        Check(serialOut == standardOut, "std::inclusive_scan");
+#endif
+        Check(serialOut == walrusOut, "ParallelInclusiveScan");
+        Report("Inclusive scan", serial, walrus, standard);
+    }
+
+    // Sort: every round sorts a fresh copy, the copy is timed in all three
+    {
+        std::vector<uint64_t> keys(elements);
+        for (size_t i = 0; i < elements; ++i) {
+            keys[i] = Mix(i + 12345);
+        }
+        double serial = Measure(rounds, [&]() {
+            serialOut = keys;
+            std::sort(serialOut.begin(), serialOut.end());
+        });
+        double walrus = Measure(rounds, [&]() {
+            walrusOut = keys;
+            ParallelSort(loop, walrusOut.begin(), walrusOut.end());
+        });
+        double standard = 0.0;
+#if WALRUS_BENCHMARK_STD_PAR
+        standard = Measure(rounds, [&]() {
+            standardOut = keys;
+            std::sort(std::execution::par, standardOut.begin(), standardOut.end());
+        });
+        Check(serialOut == standardOut, "std::sort");
+#endif
+        Check(serialOut == walrusOut, "ParallelSort");
+        Report("Sort", serial, walrus, standard);
+    }
+
+    loop.Stop();
+    std::cout << (s_Correct ? "PASS: parallel results match the serial ones" : "FAIL: results differ") << std::endl;
+    return s_Correct ? 0 : 1;
+}
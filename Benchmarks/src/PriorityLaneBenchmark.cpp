@@ -0,0 +1,90 @@
+// Queueing delay of a heartbeat while the pool is saturated with bulk work. A 1 ms interval runs
+// once as a normal task behind a flood of normal tasks and once in the Critical lane with the
+// flood in the Background lane. The wait times come from EventLoopStats::Lanes; the bulk count
+// shows that the flood still progresses.
+// Usage: PriorityLaneBenchmark [seconds=2] [work_us=500]
+
+#include "Walrus/EventLoop.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace Walrus;
+
+static void BusyWait(std::chrono::microseconds duration) {
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+static void Run(bool lanes, double seconds, int workUs) {
+    EventLoop loop;
+    loop.Start();
+
+    const TaskPriority heartbeatPriority = lanes ? TaskPriority::Critical : TaskPriority::Normal;
+    const TaskPriority bulkPriority = lanes ? TaskPriority::Background : TaskPriority::Normal;
+    std::atomic<bool> flooding{true};
+    std::atomic<uint64_t> bulkDone{0};
+    std::atomic<size_t> inFlight{0};
+
+    // Keep plenty of bulk tasks queued at all times
+    std::thread producer([&]() {
+        while (flooding.load()) {
+            while (inFlight.load() < 64) {
+                inFlight.fetch_add(1);
+                loop.Post([&, workUs]() {
+                    BusyWait(std::chrono::microseconds(workUs));
+                    bulkDone.fetch_add(1);
+                    inFlight.fetch_sub(1);
+                }, bulkPriority);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+
+    std::atomic<uint64_t> heartbeats{0};
+    TimerSpecification spec;
+    spec.Policy = IntervalPolicy::Skip;
+    spec.Priority = heartbeatPriority;
+    EventId id = loop.SetInterval([&]() { heartbeats.fetch_add(1); }, 1, spec);
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    loop.ClearInterval(id);
+    flooding.store(false);
+    producer.join();
+
+    const EventLoopStats stats = loop.GetStats();
+    loop.Stop();
+
+    // In single-lane mode the heartbeat shares its lane statistics with the flood
+    const TaskLaneStats& heartbeat = stats.Lanes[TaskLane(heartbeatPriority)];
+    const TaskLaneStats& bulk = stats.Lanes[TaskLane(bulkPriority)];
+    std::cout << std::left << std::setw(22) << (lanes ? "Critical/Background" : "Single lane") << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(12) << heartbeats.load()
+              << std::setw(18) << heartbeat.AverageWait.count() / 1000.0
+              << std::setw(18) << heartbeat.MaxWait.count() / 1000.0
+              << std::setw(12) << bulkDone.load()
+              << std::setw(18) << bulk.AverageWait.count() / 1000.0 << std::endl;
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 2.0;
+    int workUs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 500;
+
+    std::cout << "1 ms heartbeat under a flood of " << workUs << " us tasks, " << seconds << " s per run" << std::endl;
+    std::cout << std::left << std::setw(22) << "Mode" << std::right
+              << std::setw(12) << "Heartbeats"
+              << std::setw(18) << "Avg wait us"
+              << std::setw(18) << "Max wait us"
+              << std::setw(12) << "Bulk tasks"
+              << std::setw(18) << "Bulk avg wait us" << std::endl;
+
+    Run(false, seconds, workUs);
+    Run(true, seconds, workUs);
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Strand throughput versus the mutex-protected equivalent. Producer threads post tiny updates to
+// a set of counters: through one Strand per counter (plain int, no lock) or straight to the
+// pool with a mutex per counter. Each run ends once every update has executed; the strand
+// counters are checked afterwards, since a strand that overlapped its tasks would lose updates.
+// Usage: StrandBenchmark [producers=4] [updates=400000]
+
+#include "Walrus/Strand.h"
+#include "Walrus/Timer.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Walrus;
+
+struct Counter {
+    std::mutex Mutex;
+    uint64_t Value = 0;
+};
+
+// Updates per second from the first post until the last update has run
+static double Run(EventLoop& loop, bool strands, size_t counterCount, size_t producers, uint64_t updates, bool& correct) {
+    std::vector<std::unique_ptr<Counter>> counters;
+    std::vector<Strand> strandList;
+    for (size_t i = 0; i < counterCount; ++i) {
+        counters.push_back(std::make_unique<Counter>());
+        strandList.emplace_back(loop);
+    }
+
+    std::atomic<uint64_t> done{0};
+    const uint64_t perProducer = updates / producers;
+    const uint64_t total = perProducer * producers;
+
+    Timer timer;
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p]() {
+            for (uint64_t i = 0; i < perProducer; ++i) {
+                const size_t target = (p + i) % counterCount;
+                Counter* counter = counters[target].get();
+
+                if (strands) {
+                    strandList[target].Post([counter, &done]() {
+                        counter->Value++;
+                        done.fetch_add(1, std::memory_order_release);
+                    });
+                } else {
+                    loop.Post([counter, &done]() {
+                        std::lock_guard<std::mutex> lock(counter->Mutex);
+                        counter->Value++;
+                        done.fetch_add(1, std::memory_order_release);
+                    });
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    while (done.load(std::memory_order_acquire) < total) {
+        std::this_thread::yield();
+    }
+    double rate = total / timer.Elapsed();
+
+    uint64_t sum = 0;
+    for (auto& counter : counters) {
+        sum += counter->Value;
+    }
+    correct = correct && sum == total;
+    return rate;
+}
+
+int main(int argc, char** argv) {
+    size_t producers = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4;
+    uint64_t updates = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 400000;
+    producers = std::max<size_t>(producers, 1);
+
+    EventLoop loop;
+    loop.Start();
+
+    bool correct = true;
+    std::cout << producers << " producers, " << updates << " updates per run" << std::endl;
+    std::cout << std::left << std::setw(10) << "Counters" << std::right
+              << std::setw(18) << "Strand updates/s"
+              << std::setw(18) << "Mutex updates/s" << std::endl;
+
+    for (size_t counters : { 1, 4, 16, 64 }) {
+        double strand = Run(loop, true, counters, producers, updates, correct);
+        double mutex = Run(loop, false, counters, producers, updates, correct);
+
+        std::cout << std::left << std::setw(10) << counters << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(18) << strand
+                  << std::setw(18) << mutex << std::endl;
+    }
+
+    loop.Stop();
+    std::cout << (correct ? "PASS: no update was lost" : "FAIL: updates were lost") << std::endl;
+    return correct ? 0 : 1;
+}
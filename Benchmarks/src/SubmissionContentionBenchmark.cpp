@@ -0,0 +1,168 @@
+// Submission throughput under contention: 1..64 producer threads pushing tiny callbacks at once.
+// Compares the previous immediate queue (mutex + Slab + RingQueue) with the lock-free MpscQueue
+// while one consumer drains them, then measures EventLoop::SetImmediate and Post end to end.
+// Usage: SubmissionContentionBenchmark [maxProducers=64] [submissions=400000]
+
+#include "Walrus/EventLoop.h"
+#include "Walrus/MpscQueue.h"
+#include "Walrus/RingQueue.h"
+#include "Walrus/Slab.h"
+#include "Walrus/Timer.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Walrus;
+
+// The immediate queue EventLoop used before the lock-free one, kept here as the baseline
+class MutexQueue {
+public:
+    MutexQueue() {
+        m_Records.Reserve(WALRUS_EVENT_LOOP_IMMEDIATE_POOL_CAPACITY);
+        m_Order.Reserve(WALRUS_EVENT_LOOP_IMMEDIATE_POOL_CAPACITY);
+    }
+
+    void Push(EventCallback callback) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        uint32_t index = m_Records.Acquire();
+        m_Records[index] = std::move(callback);
+        m_Order.Push(index);
+    }
+
+    bool Pop(EventCallback& callback) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_Order.Empty()) {
+            return false;
+        }
+        uint32_t index = m_Order.Pop();
+        callback = std::move(m_Records[index]);
+        m_Records.Release(index);
+        return true;
+    }
+
+private:
+    std::mutex m_Mutex;
+    Slab<EventCallback> m_Records;
+    RingQueue<uint32_t> m_Order;
+};
+
+struct LockFreeQueue {
+    MpscQueue<EventCallback> Queue{WALRUS_EVENT_LOOP_IMMEDIATE_POOL_CAPACITY};
+
+    void Push(EventCallback callback) {
+        uint32_t generation;
+        Queue.Push(std::move(callback), generation);
+    }
+
+    bool Pop(EventCallback& callback) { return Queue.Pop(callback); }
+};
+
+// Run submit(i) submissions / producers times on each producer thread, all released at once.
+// Returns submissions per second measured from the release until the last producer is done.
+template<typename Submit>
+static double RunProducers(size_t producers, uint64_t submissions, Submit submit) {
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    const uint64_t perProducer = submissions / producers;
+
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&]() {
+            ready.fetch_add(1);
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            for (uint64_t i = 0; i < perProducer; ++i) {
+                submit();
+            }
+        });
+    }
+
+    while (ready.load() < producers) {
+        std::this_thread::yield();
+    }
+
+    Timer timer;
+    go.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return perProducer * producers / timer.Elapsed();
+}
+
+template<typename Queue>
+static double QueueThroughput(size_t producers, uint64_t submissions) {
+    Queue queue;
+    std::atomic<bool> producing{true};
+    std::atomic<uint64_t> consumed{0};
+
+    // Single consumer draining concurrently, like the loop thread
+    std::thread consumer([&]() {
+        EventCallback callback;
+        while (true) {
+            if (queue.Pop(callback)) {
+                callback();
+                consumed.fetch_add(1, std::memory_order_relaxed);
+            } else if (!producing.load()) {
+                break;
+            }
+        }
+    });
+
+    std::atomic<uint64_t> sink{0};
+    double rate = RunProducers(producers, submissions, [&]() {
+        queue.Push([&sink]() { sink.fetch_add(1, std::memory_order_relaxed); });
+    });
+
+    producing.store(false);
+    consumer.join();
+    return rate;
+}
+
+static double LoopThroughput(EventLoop& loop, bool post, size_t producers, uint64_t submissions) {
+    std::atomic<uint64_t> ran{0};
+    double rate = RunProducers(producers, submissions, [&]() {
+        auto callback = [&ran]() { ran.fetch_add(1, std::memory_order_relaxed); };
+        if (post) {
+            loop.Post(callback);
+        } else {
+            loop.SetImmediate(callback);
+        }
+    });
+
+    const uint64_t expected = submissions / producers * producers;
+    while (ran.load() < expected) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return rate;
+}
+
+int main(int argc, char** argv) {
+    size_t maxProducers = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    uint64_t submissions = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 400000;
+
+    EventLoop loop;
+    loop.Start();
+
+    std::cout << std::left << std::setw(11) << "Producers" << std::right
+              << std::setw(16) << "Mutex push/s"
+              << std::setw(16) << "Mpsc push/s"
+              << std::setw(18) << "SetImmediate/s"
+              << std::setw(16) << "Post/s" << std::endl;
+
+    for (size_t producers = 1; producers <= maxProducers; producers *= 2) {
+        std::cout << std::left << std::setw(11) << producers << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(16) << QueueThroughput<MutexQueue>(producers, submissions)
+                  << std::setw(16) << QueueThroughput<LockFreeQueue>(producers, submissions)
+                  << std::setw(18) << LoopThroughput(loop, false, producers, submissions)
+                  << std::setw(16) << LoopThroughput(loop, true, producers, submissions) << std::endl;
+    }
+
+    loop.Stop();
+    return 0;
+}
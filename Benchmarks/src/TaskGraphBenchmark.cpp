@@ -0,0 +1,184 @@
+// Rerunning a fixed dependency graph: TaskGraph versus chaining SetImmediate calls from the
+// callbacks. The graph has layers of tasks; task j of a layer needs tasks j and j+1 of the layer
+// before it. In the chained version each finishing task counts down its successors and calls
+// SetImmediate for the ones it releases, so every edge goes through the loop thread. Both compute
+// the same values, which are compared at the end.
+// Usage: TaskGraphBenchmark [layers=16] [width=32] [work=2000] [runs=200]
+
+#include "Walrus/TaskGraph.h"
+#include "Walrus/Timer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Walrus;
+
+struct Shape {
+    size_t layers;
+    size_t width;
+    int work;
+
+    size_t Count() const { return layers * width; }
+    size_t Index(size_t layer, size_t j) const { return layer * width + j; }
+
+    // Predecessors of task j in layer (none in the first layer)
+    std::vector<size_t> Inputs(size_t layer, size_t j) const {
+        if (layer == 0) {
+            return {};
+        }
+        std::vector<size_t> inputs{ Index(layer - 1, j) };
+        if (width > 1) {
+            inputs.push_back(Index(layer - 1, (j + 1) % width));
+        }
+        return inputs;
+    }
+};
+
+// Stand-in for a short computation: work steps of a linear congruential generator
+static uint64_t Compute(uint64_t value, int work) {
+    for (int i = 0; i < work; ++i) {
+        value = value * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    return value;
+}
+
+static void RunTask(const Shape& shape, std::vector<uint64_t>& values, const std::vector<std::vector<size_t>>& inputs,
+                    size_t node, uint64_t run) {
+    uint64_t value = node + run;
+    for (size_t input : inputs[node]) {
+        value += values[input];
+    }
+    values[node] = Compute(value, shape.work);
+}
+
+static uint64_t Checksum(const std::vector<uint64_t>& values) {
+    uint64_t checksum = 0;
+    for (uint64_t value : values) {
+        checksum ^= value;
+    }
+    return checksum;
+}
+
+// Graph runs per second
+static double RunGraph(EventLoop& loop, const Shape& shape, const std::vector<std::vector<size_t>>& inputs,
+                       size_t runs, uint64_t& checksum) {
+    std::vector<uint64_t> values(shape.Count());
+    uint64_t run = 0;
+
+    TaskGraph graph;
+    for (size_t node = 0; node < shape.Count(); ++node) {
+        graph.Add([&, node]() { RunTask(shape, values, inputs, node, run); });
+    }
+    for (size_t node = 0; node < shape.Count(); ++node) {
+        for (size_t input : inputs[node]) {
+            graph.RunAfter(node, input);
+        }
+    }
+
+    checksum = 0;
+    Timer timer;
+    for (run = 0; run < runs; ++run) {
+        graph.Run(loop);
+        graph.Wait();
+        checksum ^= Checksum(values);
+    }
+    return runs / timer.Elapsed();
+}
+
+static double RunChained(EventLoop& loop, const Shape& shape, const std::vector<std::vector<size_t>>& inputs,
+                         size_t runs, uint64_t& checksum) {
+    const size_t count = shape.Count();
+    std::vector<uint64_t> values(count);
+    std::vector<std::vector<size_t>> successors(count);
+    for (size_t node = 0; node < count; ++node) {
+        for (size_t input : inputs[node]) {
+            successors[input].push_back(node);
+        }
+    }
+    std::unique_ptr<std::atomic<uint32_t>[]> pending(new std::atomic<uint32_t>[count]);
+    std::atomic<size_t> finished{0};
+    uint64_t run = 0;
+
+    struct Chain {
+        EventLoop& loop;
+        const Shape& shape;
+        const std::vector<std::vector<size_t>>& inputs;
+        const std::vector<std::vector<size_t>>& successors;
+        std::vector<uint64_t>& values;
+        std::atomic<uint32_t>* pending;
+        std::atomic<size_t>& finished;
+        const uint64_t& run;
+
+        void Start(size_t node) {
+            loop.SetImmediate([this, node]() {
+                RunTask(shape, values, inputs, node, run);
+                for (size_t successor : successors[node]) {
+                    if (pending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        Start(successor);
+                    }
+                }
+                finished.fetch_add(1, std::memory_order_release);
+            });
+        }
+    } chain{ loop, shape, inputs, successors, values, pending.get(), finished, run };
+
+    checksum = 0;
+    Timer timer;
+    for (run = 0; run < runs; ++run) {
+        finished.store(0);
+        for (size_t node = 0; node < count; ++node) {
+            pending[node].store(static_cast<uint32_t>(inputs[node].size()));
+        }
+        for (size_t j = 0; j < shape.width; ++j) {
+            chain.Start(shape.Index(0, j));
+        }
+        while (finished.load(std::memory_order_acquire) < count) {
+            std::this_thread::yield();
+        }
+        checksum ^= Checksum(values);
+    }
+    return runs / timer.Elapsed();
+}
+
+int main(int argc, char** argv) {
+    Shape shape;
+    shape.layers = argc > 1 ? std::max<size_t>(1, std::strtoul(argv[1], nullptr, 10)) : 16;
+    shape.width = argc > 2 ? std::max<size_t>(1, std::strtoul(argv[2], nullptr, 10)) : 32;
+    shape.work = argc > 3 ? std::max(0, std::atoi(argv[3])) : 2000;
+    size_t runs = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 200;
+
+    std::vector<std::vector<size_t>> inputs(shape.Count());
+    for (size_t layer = 0; layer < shape.layers; ++layer) {
+        for (size_t j = 0; j < shape.width; ++j) {
+            inputs[shape.Index(layer, j)] = shape.Inputs(layer, j);
+        }
+    }
+
+    EventLoop loop;
+    loop.Start();
+
+    std::cout << shape.layers << " layers x " << shape.width << " tasks, " << shape.work << " steps per task, "
+              << runs << " runs" << std::endl;
+
+    uint64_t chainedChecksum = 0;
+    uint64_t graphChecksum = 0;
+    double chained = RunChained(loop, shape, inputs, runs, chainedChecksum);
+    double graph = RunGraph(loop, shape, inputs, runs, graphChecksum);
+
+    std::cout << std::left << std::setw(14) << "SetImmediate" << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << chained << " runs/s" << std::endl;
+    std::cout << std::left << std::setw(14) << "TaskGraph" << std::right
+              << std::setw(10) << graph << " runs/s" << std::endl;
+
+    loop.Stop();
+
+    bool correct = chainedChecksum == graphChecksum;
+    std::cout << (correct ? "PASS: both produced the same values" : "FAIL: values differ") << std::endl;
+    return correct ? 0 : 1;
+}
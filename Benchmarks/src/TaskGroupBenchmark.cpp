@@ -0,0 +1,113 @@
+// Recursive divide and conquer with TaskGroup: a parallel quicksort and a parallel Fibonacci whose
+// tasks wait for their subtasks on pool workers. Far more tasks wait at once than the pool has
+// workers, which only completes because waiting workers run the queued subtasks themselves.
+// Results are checked against the serial versions.
+// Usage: TaskGroupBenchmark [elements=4000000] [fib=32] [cutoff=4096]
+
+#include "Walrus/TaskGroup.h"
+#include "Walrus/Timer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace Walrus;
+
+static void ParallelQuicksort(EventLoop& loop, uint64_t* first, uint64_t* last, size_t cutoff) {
+    if (static_cast<size_t>(last - first) <= cutoff) {
+        std::sort(first, last);
+        return;
+    }
+
+    const uint64_t a = first[0], b = first[(last - first) / 2], c = last[-1];
+    const uint64_t pivot = std::max(std::min(a, b), std::min(std::max(a, b), c)); // Median of three
+    uint64_t* middle1 = std::partition(first, last, [pivot](uint64_t value) { return value < pivot; });
+    uint64_t* middle2 = std::partition(middle1, last, [pivot](uint64_t value) { return !(pivot < value); });
+
+    // Fork the left part, sort the right one here, then join
+    TaskGroup group(loop);
+    group.Run([&loop, first, middle1, cutoff]() { ParallelQuicksort(loop, first, middle1, cutoff); });
+    ParallelQuicksort(loop, middle2, last, cutoff);
+    group.Wait();
+}
+
+static uint64_t SerialFib(int n) {
+    return n < 2 ? static_cast<uint64_t>(n) : SerialFib(n - 1) + SerialFib(n - 2);
+}
+
+static uint64_t ParallelFib(EventLoop& loop, int n) {
+    if (n < 18) {
+        return SerialFib(n);
+    }
+    uint64_t a = 0;
+    TaskGroup group(loop);
+    group.Run([&loop, &a, n]() { a = ParallelFib(loop, n - 1); });
+    uint64_t b = ParallelFib(loop, n - 2);
+    group.Wait();
+    return a + b;
+}
+
+static void Report(const char* name, double serial, double parallel) {
+    std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << serial * 1e3
+              << std::setw(14) << parallel * 1e3
+              << std::setw(9) << serial / parallel << "x" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t elements = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4000000;
+    int fib = argc > 2 ? std::max(0, std::atoi(argv[2])) : 32;
+    size_t cutoff = argc > 3 ? std::max<size_t>(16, std::strtoul(argv[3], nullptr, 10)) : 4096;
+
+    EventLoop loop;
+    loop.Start();
+
+    std::vector<uint64_t> keys(elements);
+    uint64_t seed = 12345;
+    for (auto& key : keys) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        key = seed >> 16;
+    }
+
+    std::cout << loop.GetWorkerCount() << " workers" << std::endl;
+    std::cout << std::left << std::setw(12) << "Workload" << std::right
+              << std::setw(12) << "Serial ms"
+              << std::setw(14) << "TaskGroup ms"
+              << std::setw(10) << "Speedup" << std::endl;
+
+    bool correct = true;
+
+    std::vector<uint64_t> serialKeys = keys;
+    Timer serialSortTimer;
+    std::sort(serialKeys.begin(), serialKeys.end());
+    double serialSort = serialSortTimer.Elapsed();
+
+    // Started from a pool task, so even the root waits on a worker
+    std::vector<uint64_t> parallelKeys = keys;
+    Timer parallelSortTimer;
+    TaskGroup sortRoot(loop);
+    sortRoot.Run([&]() { ParallelQuicksort(loop, parallelKeys.data(), parallelKeys.data() + parallelKeys.size(), cutoff); });
+    sortRoot.Wait();
+    double parallelSort = parallelSortTimer.Elapsed();
+    correct = correct && parallelKeys == serialKeys;
+    Report("Quicksort", serialSort, parallelSort);
+
+    Timer serialFibTimer;
+    uint64_t serialFib = SerialFib(fib);
+    double serialFibTime = serialFibTimer.Elapsed();
+
+    uint64_t parallelFib = 0;
+    Timer parallelFibTimer;
+    TaskGroup fibRoot(loop);
+    fibRoot.Run([&]() { parallelFib = ParallelFib(loop, fib); });
+    fibRoot.Wait();
+    double parallelFibTime = parallelFibTimer.Elapsed();
+    correct = correct && parallelFib == serialFib;
+    Report("Fibonacci", serialFibTime, parallelFibTime);
+
+    loop.Stop();
+    std::cout << (correct ? "PASS: parallel results match the serial ones" : "FAIL: results differ") << std::endl;
+    return correct ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+// Thread pool scalability: tiny-task throughput of the work-stealing ThreadPool against the previous
+// design (one queue, one mutex, one condition variable) for 1..N worker threads.
+// Usage: ThreadPoolBenchmark [maxThreads=hardware_concurrency] [tasks=200000]
+
+#include "Walrus/ThreadPool.h"
+#include "Walrus/Timer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace Walrus;
+
+// The pool EventLoop used before the work-stealing pool, kept here as the baseline
+class SingleQueuePool {
+public:
+    explicit SingleQueuePool(size_t threadCount) {
+        for (size_t i = 0; i < threadCount; ++i) {
+            m_Threads.emplace_back([this]() {
+                while (true) {
+                    EventCallback task;
+                    {
+                        std::unique_lock<std::mutex> lock(m_Mutex);
+                        m_Condition.wait(lock, [this] { return !m_Tasks.empty() || m_Stop; });
+                        if (m_Stop && m_Tasks.empty()) {
+                            break;
+                        }
+                        task = std::move(m_Tasks.front());
+                        m_Tasks.pop();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    ~SingleQueuePool() {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_Condition.notify_all();
+        for (auto& thread : m_Threads) {
+            thread.join();
+        }
+    }
+
+    void Submit(EventCallback task) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Tasks.push(std::move(task));
+        }
+        m_Condition.notify_one();
+    }
+
+private:
+    std::vector<std::thread> m_Threads;
+    std::queue<EventCallback> m_Tasks;
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    bool m_Stop = false;
+};
+
+static std::atomic<uint64_t> g_Sink{0};
+
+static void SmallWork() {
+    uint64_t value = 0;
+    for (int i = 0; i < 64; ++i) {
+        value = value * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    g_Sink.fetch_add(value & 1, std::memory_order_relaxed);
+}
+
+static void WaitFor(const std::atomic<uint64_t>& done, uint64_t count) {
+    while (done.load(std::memory_order_acquire) < count) {
+        std::this_thread::yield();
+    }
+}
+
+// One external producer submitting every task, as the EventLoop thread does
+template<typename Pool>
+static double ExternalSubmission(size_t threads, uint64_t tasks) {
+    Pool pool(threads);
+    std::atomic<uint64_t> done{0};
+
+    Timer timer;
+    for (uint64_t i = 0; i < tasks; ++i) {
+        pool.Submit([&done]() {
+            SmallWork();
+            done.fetch_add(1, std::memory_order_release);
+        });
+    }
+    WaitFor(done, tasks);
+    return tasks / timer.Elapsed();
+}
+
+// Tasks that spawn their children from worker threads (recursive fan-out)
+template<typename Pool>
+static void Spawn(Pool& pool, std::atomic<uint64_t>& done, int depth) {
+    SmallWork();
+    if (depth > 0) {
+        pool.Submit([&pool, &done, depth]() { Spawn(pool, done, depth - 1); });
+        pool.Submit([&pool, &done, depth]() { Spawn(pool, done, depth - 1); });
+    }
+    done.fetch_add(1, std::memory_order_release);
+}
+
+template<typename Pool>
+static double FanOut(size_t threads, uint64_t tasks) {
+    int depth = 0;
+    while ((uint64_t(2) << (depth + 1)) - 1 <= tasks) {
+        ++depth;
+    }
+    const uint64_t total = (uint64_t(2) << depth) - 1;
+
+    Pool pool(threads);
+    std::atomic<uint64_t> done{0};
+
+    Timer timer;
+    pool.Submit([&pool, &done, depth]() { Spawn(pool, done, depth); });
+    WaitFor(done, total);
+    return total / timer.Elapsed();
+}
+
+int main(int argc, char** argv) {
+    size_t maxThreads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+    uint64_t tasks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000;
+    maxThreads = std::max<size_t>(maxThreads, 1);
+
+    std::cout << std::left << std::setw(9) << "Threads" << std::right
+              << std::setw(18) << "Single ext/s"
+              << std::setw(18) << "Stealing ext/s"
+              << std::setw(18) << "Single fan/s"
+              << std::setw(18) << "Stealing fan/s" << std::endl;
+
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        std::cout << std::left << std::setw(9) << threads << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(18) << ExternalSubmission<SingleQueuePool>(threads, tasks)
+                  << std::setw(18) << ExternalSubmission<ThreadPool>(threads, tasks)
+                  << std::setw(18) << FanOut<SingleQueuePool>(threads, tasks)
+                  << std::setw(18) << FanOut<ThreadPool>(threads, tasks) << std::endl;
+
+        if (threads < maxThreads && threads * 2 > maxThreads) {
+            threads = maxThreads / 2; // Always finish with maxThreads
+        }
+    }
+
+    return 0;
+}
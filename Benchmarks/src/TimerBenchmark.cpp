@@ -0,0 +1,113 @@
+// Timer backend throughput: insert, cancel and expiry rates at 10^3..10^N outstanding timers.
+// Usage: TimerBenchmark [maxExponent=6]   (use 7 for 10^7 timers, needs a few GB of RAM)
+
+#include "Walrus/TimerHeap.h"
+#include "Walrus/TimerWheel.h"
+#include "Walrus/Timer.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Walrus;
+using Clock = std::chrono::steady_clock;
+
+struct BenchmarkResult {
+    double insertPerSecond;
+    double cancelPerSecond;
+    double expirePerSecond;
+};
+
+static std::unique_ptr<TimerQueue> CreateQueue(TimerBackend backend, Clock::time_point origin) {
+    if (backend == TimerBackend::Wheel) {
+        return std::make_unique<TimerWheel>(std::chrono::milliseconds(1), origin);
+    }
+    return std::make_unique<TimerHeap>();
+}
+
+static BenchmarkResult RunBenchmark(TimerBackend backend, size_t count) {
+    const auto origin = Clock::now();
+    const auto horizon = std::chrono::seconds(60);
+
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int64_t> delay(1, std::chrono::duration_cast<std::chrono::milliseconds>(horizon).count());
+
+    std::vector<Clock::time_point> deadlines(count);
+    for (auto& deadline : deadlines) {
+        deadline = origin + std::chrono::milliseconds(delay(rng));
+    }
+
+    auto queue = CreateQueue(backend, origin);
+    BenchmarkResult result{};
+
+    // Insert
+    std::vector<EventId> ids(count);
+    Timer timer;
+    for (size_t i = 0; i < count; ++i) {
+        ids[i] = queue->Push(TimerEvent(0, [] {}, deadlines[i]));
+    }
+    result.insertPerSecond = count / timer.Elapsed();
+
+    // Cancel a tenth of the timers and arm replacements, as request timeouts do
+    const size_t churn = std::max<size_t>(count / 10, 1);
+    std::uniform_int_distribution<size_t> pick(0, count - 1);
+    timer.Reset();
+    for (size_t i = 0; i < churn; ++i) {
+        size_t victim = pick(rng);
+        queue->Cancel(ids[victim]);
+        ids[victim] = queue->Push(TimerEvent(0, [] {}, deadlines[victim]));
+    }
+    result.cancelPerSecond = churn / timer.Elapsed();
+
+    // Expire everything, advancing simulated time in 1 ms steps
+    size_t expired = 0;
+    TimerQueue::FireCallback fire = [&expired](TimerEvent&) {
+        ++expired;
+        return false;
+    };
+
+    timer.Reset();
+    for (auto now = origin; now <= origin + horizon; now += std::chrono::milliseconds(1)) {
+        queue->ProcessExpired(now, fire);
+    }
+    result.expirePerSecond = expired / timer.Elapsed();
+
+    if (!queue->Empty() || expired < count) {
+        std::cerr << "TimerBenchmark: backend left " << queue->Size() << " timers behind" << std::endl;
+    }
+
+    return result;
+}
+
+int main(int argc, char** argv) {
+    int maxExponent = argc > 1 ? std::atoi(argv[1]) : 6;
+
+    std::cout << std::left << std::setw(8) << "Backend" << std::right
+              << std::setw(12) << "Timers"
+              << std::setw(16) << "Insert/s"
+              << std::setw(16) << "Cancel+Arm/s"
+              << std::setw(16) << "Expire/s" << std::endl;
+
+    for (int exponent = 3; exponent <= maxExponent; ++exponent) {
+        size_t count = 1;
+        for (int i = 0; i < exponent; ++i) {
+            count *= 10;
+        }
+
+        for (TimerBackend backend : { TimerBackend::Heap, TimerBackend::Wheel }) {
+            BenchmarkResult result = RunBenchmark(backend, count);
+
+            std::cout << std::left << std::setw(8) << (backend == TimerBackend::Wheel ? "Wheel" : "Heap") << std::right
+                      << std::setw(12) << count << std::fixed << std::setprecision(0)
+                      << std::setw(16) << result.insertPerSecond
+                      << std::setw(16) << result.cancelPerSecond
+                      << std::setw(16) << result.expirePerSecond << std::endl;
+        }
+    }
+
+    return 0;
+}
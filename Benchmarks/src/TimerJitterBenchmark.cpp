@@ -0,0 +1,90 @@
+// Timer precision: how late SetTimeout callbacks start running for sub-millisecond and millisecond delays.
+// Lateness is measured inside the callback, so it includes the hand-off to the thread pool.
+// Usage: TimerJitterBenchmark [samples=1000]
+
+#include "Walrus/EventLoop.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+using namespace Walrus;
+using Clock = std::chrono::steady_clock;
+
+static double Percentile(const std::vector<double>& sorted, double percentile) {
+    size_t index = static_cast<size_t>(percentile / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static std::vector<double> Measure(EventLoop& loop, std::chrono::nanoseconds delay, int samples) {
+    std::vector<double> lateness;
+    lateness.reserve(samples);
+
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    for (int i = 0; i < samples; ++i) {
+        bool done = false;
+        Clock::time_point fired;
+
+        auto start = Clock::now();
+        loop.SetTimeout([&]() {
+            auto now = Clock::now();
+            std::lock_guard<std::mutex> lock(mutex);
+            fired = now;
+            done = true;
+            condition.notify_one();
+        }, delay);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return done; });
+        lateness.push_back(std::chrono::duration<double, std::micro>(fired - (start + delay)).count());
+    }
+
+    std::sort(lateness.begin(), lateness.end());
+    return lateness;
+}
+
+int main(int argc, char** argv) {
+    int samples = argc > 1 ? std::atoi(argv[1]) : 1000;
+
+    const std::vector<std::chrono::nanoseconds> delays = {
+        std::chrono::microseconds(50), std::chrono::microseconds(100), std::chrono::microseconds(250),
+        std::chrono::microseconds(500), std::chrono::milliseconds(1), std::chrono::milliseconds(5)
+    };
+
+    std::cout << "Spin window: " << WALRUS_EVENT_LOOP_SPIN_US << " us, samples per delay: " << samples << std::endl;
+    std::cout << std::left << std::setw(8) << "Backend" << std::right
+              << std::setw(12) << "Delay(us)"
+              << std::setw(11) << "p50(us)"
+              << std::setw(11) << "p90(us)"
+              << std::setw(11) << "p99(us)"
+              << std::setw(11) << "p99.9(us)"
+              << std::setw(11) << "max(us)" << std::endl;
+
+    for (TimerBackend backend : { TimerBackend::Heap, TimerBackend::Wheel }) {
+        EventLoop loop(backend);
+        loop.Start();
+
+        for (auto delay : delays) {
+            std::vector<double> lateness = Measure(loop, delay, samples);
+
+            std::cout << std::left << std::setw(8) << (backend == TimerBackend::Wheel ? "Wheel" : "Heap") << std::right
+                      << std::setw(12) << std::chrono::duration_cast<std::chrono::microseconds>(delay).count()
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(11) << Percentile(lateness, 50.0)
+                      << std::setw(11) << Percentile(lateness, 90.0)
+                      << std::setw(11) << Percentile(lateness, 99.0)
+                      << std::setw(11) << Percentile(lateness, 99.9)
+                      << std::setw(11) << lateness.back() << std::endl;
+        }
+
+        loop.Stop();
+    }
+
+    return 0;
+}
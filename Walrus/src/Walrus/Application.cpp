@@ -11,7 +11,12 @@ namespace Walrus {
 
 Application::Application(
     const ApplicationSpecification &applicationSpecification)
-    : m_Specification(applicationSpecification), m_Running(false) {
+    : m_Specification(applicationSpecification), m_Running(false)
+#if WALRUS_ENABLE_EVENT_LOOP
+      ,
+      m_EventLoop(applicationSpecification.EventLoop)
+#endif
+{
   s_Instance = this;
 
 #if WALRUS_ENABLE_PUBSUB
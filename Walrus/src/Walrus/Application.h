@@ -3,6 +3,7 @@
 
 // TODO: include if
 #include "EventLoop.h"
+#include "Future.h"
 #include "Layer.h"
 #include "LayerTree.h"
 #include <cstddef>
@@ -20,6 +21,11 @@ namespace Walrus {
 struct ApplicationSpecification {
   std::string Name = "Walrus App";
 
+#if WALRUS_ENABLE_EVENT_LOOP
+  // Timer backend and worker threads of the application's EventLoop
+  EventLoopSpecification EventLoop;
+#endif
+
 #if WALRUS_ENABLE_PUBSUB
   // PubSub broker - passed from application (defaults to nullptr)
   std::shared_ptr<IBroker> PubSubBroker = nullptr;
@@ -83,11 +89,83 @@ public:
   EventId SetTimeout(EventCallback callback, int milliseconds) {
     return m_EventLoop.SetTimeout(std::move(callback), milliseconds);
   }
+  EventId SetTimeout(EventCallback callback, int milliseconds,
+                     const TimerSpecification &specification) {
+    return m_EventLoop.SetTimeout(std::move(callback), milliseconds,
+                                  specification);
+  }
   EventId SetInterval(EventCallback callback, int milliseconds) {
     return m_EventLoop.SetInterval(std::move(callback), milliseconds);
   }
-  EventId SetImmediate(EventCallback callback) {
-    return m_EventLoop.SetImmediate(std::move(callback));
+  EventId SetInterval(EventCallback callback, int milliseconds,
+                      const TimerSpecification &specification) {
+    return m_EventLoop.SetInterval(std::move(callback), milliseconds,
+                                   specification);
+  }
+  EventId SetInterval(IntervalCallback callback, int milliseconds,
+                      const TimerSpecification &specification) {
+    return m_EventLoop.SetInterval(std::move(callback), milliseconds,
+                                   specification);
+  }
+  template <typename Rep, typename Period>
+  EventId SetTimeout(EventCallback callback,
+                     std::chrono::duration<Rep, Period> delay,
+                     const TimerSpecification &specification =
+                         TimerSpecification()) {
+    return m_EventLoop.SetTimeout(std::move(callback), delay, specification);
+  }
+  template <typename Rep, typename Period>
+  EventId SetInterval(EventCallback callback,
+                      std::chrono::duration<Rep, Period> interval,
+                      const TimerSpecification &specification =
+                          TimerSpecification()) {
+    return m_EventLoop.SetInterval(std::move(callback), interval,
+                                   specification);
+  }
+  template <typename Rep, typename Period>
+  EventId SetInterval(IntervalCallback callback,
+                      std::chrono::duration<Rep, Period> interval,
+                      const TimerSpecification &specification =
+                          TimerSpecification()) {
+    return m_EventLoop.SetInterval(std::move(callback), interval,
+                                   specification);
+  }
+  EventId SetImmediate(EventCallback callback,
+                       TaskPriority priority = TaskPriority::Normal) {
+    return m_EventLoop.SetImmediate(std::move(callback), priority);
+  }
+  bool Post(EventCallback callback,
+            TaskPriority priority = TaskPriority::Normal) {
+    return m_EventLoop.Post(std::move(callback), priority);
+  }
+  void SetImmediateBatch(std::vector<EventCallback> &callbacks,
+                         std::vector<EventId> *ids = nullptr,
+                         TaskPriority priority = TaskPriority::Normal) {
+    m_EventLoop.SetImmediateBatch(callbacks, ids, priority);
+  }
+  size_t PostBulk(std::vector<EventCallback> &callbacks,
+                  TaskPriority priority = TaskPriority::Normal) {
+    return m_EventLoop.PostBulk(callbacks, priority);
+  }
+  template <typename Function>
+  auto Submit(Function &&function,
+              TaskPriority priority = TaskPriority::Normal) {
+    return m_EventLoop.Submit(std::forward<Function>(function), priority);
+  }
+  bool PostWithDeadline(EventCallback callback,
+                        std::chrono::steady_clock::time_point deadline,
+                        TaskPriority priority = TaskPriority::Normal) {
+    return m_EventLoop.PostWithDeadline(std::move(callback), deadline, priority);
+  }
+  template <typename Rep, typename Period>
+  bool PostWithDeadline(EventCallback callback,
+                        std::chrono::duration<Rep, Period> budget,
+                        TaskPriority priority = TaskPriority::Normal) {
+    return m_EventLoop.PostWithDeadline(std::move(callback), budget, priority);
+  }
+  void SetTimeoutBatch(std::vector<TimerRequest> &timers,
+                       std::vector<EventId> *ids = nullptr) {
+    m_EventLoop.SetTimeoutBatch(timers, ids);
   }
   void ClearInterval(EventId id) { m_EventLoop.ClearInterval(id); }
   void ClearTimeout(EventId id) { m_EventLoop.ClearTimeout(id); }
@@ -25,6 +25,62 @@
     #ifndef WALRUS_EVENT_LOOP_DEBUG
         #define WALRUS_EVENT_LOOP_DEBUG 0
     #endif
+
+    // Tickless event loop: the loop thread sleeps until the earliest timer deadline or an
+    // explicit wakeup. Set to 0 to additionally poll every millisecond (legacy behavior).
+    #ifndef WALRUS_EVENT_LOOP_TICKLESS
+        #define WALRUS_EVENT_LOOP_TICKLESS 1
+    #endif
+
+    // Sub-millisecond timer precision: the loop thread sleeps until this many microseconds before
+    // a timer deadline and yields for the rest, trading some CPU for lower jitter. 0 disables spinning.
+    #ifndef WALRUS_EVENT_LOOP_SPIN_US
+        #define WALRUS_EVENT_LOOP_SPIN_US 0
+    #endif
+
+    // Linux only: block the loop thread in epoll_wait, with timers driven by a timerfd and
+    // cross-thread wakeups by an eventfd. Other platforms always use a condition variable.
+    #ifndef WALRUS_EVENT_LOOP_EPOLL
+        #define WALRUS_EVENT_LOOP_EPOLL 0
+    #endif
+
+    // Event records preallocated per EventLoop. Scheduling up to this many concurrently pending
+    // timers / immediates does not allocate; the pools grow on demand beyond it.
+    #ifndef WALRUS_EVENT_LOOP_TIMER_POOL_CAPACITY
+        #define WALRUS_EVENT_LOOP_TIMER_POOL_CAPACITY 256
+    #endif
+    #ifndef WALRUS_EVENT_LOOP_IMMEDIATE_POOL_CAPACITY
+        #define WALRUS_EVENT_LOOP_IMMEDIATE_POOL_CAPACITY 256
+    #endif
+
+    // Default TimerSpecification::MaxCatchUpCalls, the most calls one late IntervalPolicy::CatchUp tick delivers
+    #ifndef WALRUS_EVENT_LOOP_MAX_CATCH_UP_CALLS
+        #define WALRUS_EVENT_LOOP_MAX_CATCH_UP_CALLS 16
+    #endif
+
+    // Timer storage backend used by EventLoop when none is passed to its constructor
+    // WALRUS_TIMER_BACKEND_HEAP:  binary heap ordered by deadline (O(log n) insert/expiry)
+    // WALRUS_TIMER_BACKEND_WHEEL: hierarchical timing wheel (O(1) insert/cancel/expiry)
+    #define WALRUS_TIMER_BACKEND_HEAP 0
+    #define WALRUS_TIMER_BACKEND_WHEEL 1
+    #ifndef WALRUS_EVENT_LOOP_TIMER_BACKEND
+        #define WALRUS_EVENT_LOOP_TIMER_BACKEND WALRUS_TIMER_BACKEND_HEAP
+    #endif
+
+    // Resolution of one timing wheel tick in microseconds
+    #ifndef WALRUS_EVENT_LOOP_TIMER_WHEEL_TICK_US
+        #define WALRUS_EVENT_LOOP_TIMER_WHEEL_TICK_US 1000
+    #endif
+
+    // co_await support (Coroutine.h), requires C++20: cmake -DWALRUS_ENABLE_COROUTINES=ON
+    #ifndef WALRUS_ENABLE_COROUTINES
+        #define WALRUS_ENABLE_COROUTINES 0
+    #endif
+
+    // Coroutine frames up to this many bytes are recycled through per-thread free lists
+    #ifndef WALRUS_COROUTINE_FRAME_CACHE_MAX_SIZE
+        #define WALRUS_COROUTINE_FRAME_CACHE_MAX_SIZE 1024
+    #endif
 #endif
 
 // PubSub Configuration
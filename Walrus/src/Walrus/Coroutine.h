@@ -0,0 +1,214 @@
+#ifndef WALRUS_COROUTINE_H
+#define WALRUS_COROUTINE_H
+
+#include "Config.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP && WALRUS_ENABLE_COROUTINES
+
+#include "Future.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <new>
+
+// C++20 coroutines on top of the EventLoop. A function returning Future<T> may co_await and
+// co_return; it starts running right away on the calling thread and its Future completes with the
+// co_returned value, or with the exception that escaped it:
+//
+//     Future<int> Fetch(EventLoop& loop) {
+//         co_await loop.Delay(std::chrono::milliseconds(50)); // resumes on a pool worker
+//         int value = co_await loop.Submit([] { return Compute(); });
+//         co_return value + 1;
+//     }
+//
+// co_await loop.Schedule() moves the coroutine onto the pool, co_await loop.Delay(d) resumes it
+// there after d without holding a thread, and co_await on any Future<T> resumes it once the value
+// is ready: on the pool for futures from that loop, otherwise on the thread that completes it.
+
+namespace Walrus {
+
+    namespace Detail {
+
+        // Recycles coroutine frames through per-thread free lists, one per 64-byte size class up to
+        // WALRUS_COROUTINE_FRAME_CACHE_MAX_SIZE. A frame is returned to the list of the thread that
+        // finishes the coroutine, which is usually a pool worker that starts the next one soon.
+        class CoroutineFrameCache {
+        public:
+            static constexpr size_t Granularity = 64;
+            static constexpr size_t ClassCount = WALRUS_COROUTINE_FRAME_CACHE_MAX_SIZE / Granularity;
+            static constexpr size_t MaxCachedFrames = 1024; // Per class and thread, the rest go back to the heap
+
+            static void* Allocate(size_t size) {
+                const size_t sizeClass = ClassOf(size);
+                if (sizeClass >= ClassCount) {
+                    return ::operator new(size);
+                }
+
+                CoroutineFrameCache& cache = Local();
+                if (FreeFrame* frame = cache.m_Free[sizeClass]) {
+                    cache.m_Free[sizeClass] = frame->next;
+                    cache.m_Count[sizeClass]--;
+                    return frame;
+                }
+                return ::operator new((sizeClass + 1) * Granularity);
+            }
+
+            static void Free(void* pointer, size_t size) {
+                const size_t sizeClass = ClassOf(size);
+                if (sizeClass >= ClassCount) {
+                    ::operator delete(pointer);
+                    return;
+                }
+
+                CoroutineFrameCache& cache = Local();
+                if (cache.m_Count[sizeClass] >= MaxCachedFrames) {
+                    ::operator delete(pointer);
+                    return;
+                }
+                cache.m_Free[sizeClass] = new (pointer) FreeFrame{ cache.m_Free[sizeClass] };
+                cache.m_Count[sizeClass]++;
+            }
+
+        private:
+            struct FreeFrame {
+                FreeFrame* next;
+            };
+
+            CoroutineFrameCache() = default;
+            ~CoroutineFrameCache() {
+                for (FreeFrame* frame : m_Free) {
+                    while (frame) {
+                        FreeFrame* next = frame->next;
+                        ::operator delete(frame);
+                        frame = next;
+                    }
+                }
+            }
+
+            static size_t ClassOf(size_t size) { return (size + Granularity - 1) / Granularity - 1; }
+
+            static CoroutineFrameCache& Local() {
+                thread_local CoroutineFrameCache cache;
+                return cache;
+            }
+
+        private:
+            FreeFrame* m_Free[ClassCount] = {};
+            size_t m_Count[ClassCount] = {};
+        };
+
+        // Promise of a coroutine that returns Future<T>. The coroutine runs eagerly and its frame
+        // is freed as soon as it finishes; the shared state outlives it for the consumer.
+        template<typename T>
+        struct FuturePromiseBase {
+            std::shared_ptr<FutureState<T>> state = std::make_shared<FutureState<T>>(nullptr);
+
+            static void* operator new(size_t size) { return CoroutineFrameCache::Allocate(size); }
+            static void operator delete(void* pointer, size_t size) { CoroutineFrameCache::Free(pointer, size); }
+
+            Future<T> get_return_object() { return FutureAccess::Make(state); }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void unhandled_exception() { state->SetException(std::current_exception()); }
+        };
+
+        template<typename T>
+        struct FuturePromise : FuturePromiseBase<T> {
+            template<typename U = T>
+            void return_value(U&& value) { this->state->SetValue(std::forward<U>(value)); }
+        };
+
+        template<>
+        struct FuturePromise<void> : FuturePromiseBase<void> {
+            void return_void() { state->SetValue(Unit{}); }
+        };
+
+        // co_await on a Future: suspends until its state completes and resumes where its
+        // continuations would run, on the future's loop or inline on the completing thread
+        template<typename T>
+        struct FutureAwaiter {
+            std::shared_ptr<FutureState<T>> state;
+
+            bool await_ready() const { return state->IsReady(); }
+
+            void await_suspend(std::coroutine_handle<> handle) {
+                EventLoop* loop = state->loop;
+                state->OnReady([handle, loop]() {
+                    if (loop) {
+                        loop->PostContinuation([handle]() { handle.resume(); });
+                    } else {
+                        handle.resume();
+                    }
+                });
+            }
+
+            T await_resume() {
+                if constexpr (std::is_void_v<T>) {
+                    state->TakeValue();
+                } else {
+                    return state->TakeValue();
+                }
+            }
+        };
+
+    } // namespace Detail
+
+    // Returned by EventLoop::Delay: resumes the coroutine on the pool once delay has passed
+    struct DelayAwaiter {
+        EventLoop& loop;
+        std::chrono::nanoseconds delay;
+        TaskPriority priority;
+
+        bool await_ready() const { return false; }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            TimerSpecification specification;
+            specification.Priority = priority;
+            // Not subject to the timer limit: refusing would leave the coroutine suspended for good
+            loop.AddTimer([handle]() { handle.resume(); }, nullptr, delay, false, specification, false);
+        }
+
+        void await_resume() const {}
+    };
+
+    // Returned by EventLoop::Schedule: resumes the coroutine on the pool right away
+    struct ScheduleAwaiter {
+        EventLoop& loop;
+        TaskPriority priority;
+
+        bool await_ready() const { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { loop.PostContinuation([handle]() { handle.resume(); }, priority); }
+        void await_resume() const {}
+    };
+
+    template<typename Rep, typename Period>
+    DelayAwaiter EventLoop::Delay(std::chrono::duration<Rep, Period> delay, TaskPriority priority) {
+        return DelayAwaiter{ *this, ToNanoseconds(delay), priority };
+    }
+
+    inline ScheduleAwaiter EventLoop::Schedule(TaskPriority priority) {
+        return ScheduleAwaiter{ *this, priority };
+    }
+
+    // Consumes the future
+    template<typename T>
+    Detail::FutureAwaiter<T> operator co_await(Future<T>& future) {
+        return Detail::FutureAwaiter<T>{ Detail::FutureAccess::Take(future) };
+    }
+
+    template<typename T>
+    Detail::FutureAwaiter<T> operator co_await(Future<T>&& future) {
+        return Detail::FutureAwaiter<T>{ Detail::FutureAccess::Take(future) };
+    }
+
+} // namespace Walrus
+
+// Lets any function returning Walrus::Future<T> be a coroutine
+template<typename T, typename... Args>
+struct std::coroutine_traits<Walrus::Future<T>, Args...> {
+    using promise_type = Walrus::Detail::FuturePromise<T>;
+};
+
+#endif // WALRUS_ENABLE_EVENT_LOOP && WALRUS_ENABLE_COROUTINES
+
+#endif // WALRUS_COROUTINE_H
@@ -0,0 +1,93 @@
+#include "EpollPoller.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP && defined(WL_PLATFORM_LINUX)
+
+#include <cerrno>
+#include <cstdint>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace Walrus {
+
+    EpollPoller::EpollPoller() {
+        m_EpollFd = epoll_create1(EPOLL_CLOEXEC);
+        m_TimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        m_WakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (!IsValid()) {
+            return;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = m_TimerFd;
+        epoll_ctl(m_EpollFd, EPOLL_CTL_ADD, m_TimerFd, &event);
+
+        event.data.fd = m_WakeFd;
+        epoll_ctl(m_EpollFd, EPOLL_CTL_ADD, m_WakeFd, &event);
+    }
+
+    EpollPoller::~EpollPoller() {
+        for (int fd : { m_EpollFd, m_TimerFd, m_WakeFd }) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    bool EpollPoller::Wait(TimePoint deadline) {
+        ArmTimer(deadline);
+
+        epoll_event events[2];
+        int count;
+        do {
+            count = epoll_wait(m_EpollFd, events, 2, -1);
+        } while (count < 0 && errno == EINTR);
+
+        bool notified = false;
+        for (int i = 0; i < count; ++i) {
+            uint64_t value;
+            if (events[i].data.fd == m_WakeFd) {
+                // Reading resets the eventfd counter, coalescing all notifications since the last wait
+                notified = read(m_WakeFd, &value, sizeof(value)) == sizeof(value);
+            } else if (events[i].data.fd == m_TimerFd) {
+                if (read(m_TimerFd, &value, sizeof(value)) == sizeof(value)) {
+                    m_ArmedDeadline = TimePoint::max(); // One-shot timer has expired
+                }
+            }
+        }
+        return notified;
+    }
+
+    void EpollPoller::Notify() {
+        const uint64_t one = 1;
+        ssize_t written = write(m_WakeFd, &one, sizeof(one));
+        (void)written; // Only fails when the counter would overflow, which still leaves it readable
+    }
+
+    void EpollPoller::ArmTimer(TimePoint deadline) {
+        if (deadline == m_ArmedDeadline) {
+            return;
+        }
+        m_ArmedDeadline = deadline;
+
+        itimerspec spec{};
+        if (deadline != TimePoint::max()) {
+            // A zero it_value would disarm the timer, so deadlines at or before the epoch become 1 ns
+            int64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+            if (nanoseconds < 1) {
+                nanoseconds = 1;
+            }
+            spec.it_value.tv_sec = static_cast<time_t>(nanoseconds / 1000000000);
+            spec.it_value.tv_nsec = static_cast<long>(nanoseconds % 1000000000);
+        }
+
+        // A deadline in the past makes the timerfd readable immediately
+        timerfd_settime(m_TimerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+    }
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP && WL_PLATFORM_LINUX
@@ -0,0 +1,42 @@
+#ifndef WALRUS_EPOLLPOLLER_H
+#define WALRUS_EPOLLPOLLER_H
+
+#include "EventPoller.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP && defined(WL_PLATFORM_LINUX)
+
+namespace Walrus {
+
+    // Linux poller: the loop thread blocks in epoll_wait on a timerfd armed with the next
+    // deadline (absolute CLOCK_MONOTONIC, the clock behind steady_clock) and an eventfd
+    // that other threads write to. Further descriptors can be added to the same epoll set.
+    class EpollPoller : public EventPoller {
+    public:
+        EpollPoller();
+        ~EpollPoller() override;
+
+        EpollPoller(const EpollPoller&) = delete;
+        EpollPoller& operator=(const EpollPoller&) = delete;
+
+        // False if one of the descriptors could not be created
+        bool IsValid() const { return m_EpollFd >= 0 && m_TimerFd >= 0 && m_WakeFd >= 0; }
+
+        bool Wait(TimePoint deadline) override;
+        void Notify() override;
+        const char* GetName() const override { return "epoll"; }
+
+    private:
+        void ArmTimer(TimePoint deadline);
+
+    private:
+        int m_EpollFd = -1;
+        int m_TimerFd = -1;
+        int m_WakeFd = -1;
+        TimePoint m_ArmedDeadline = TimePoint::max(); // Avoids re-arming the timerfd for an unchanged deadline
+    };
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP && WL_PLATFORM_LINUX
+
+#endif // WALRUS_EPOLLPOLLER_H
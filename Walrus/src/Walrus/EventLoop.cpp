@@ -2,50 +2,76 @@
 
 #if WALRUS_ENABLE_EVENT_LOOP
 
+#include "TimerHeap.h"
+#include "TimerWheel.h"
+
 #include <iostream>
 #include <algorithm>
 
+#if defined(WL_PLATFORM_LINUX)
+#include <sys/prctl.h>
+#endif
+
 namespace Walrus {
 
-    EventLoop::EventLoop() 
-        : m_TimerQueue([](const std::shared_ptr<TimerEvent>& a, const std::shared_ptr<TimerEvent>& b) {
-            return a->nextExecution > b->nextExecution; // Min-heap based on execution time
-        })
+    namespace {
+
+        // Round a deadline up to a grid of the largest power-of-two nanoseconds not above the
+        // tolerance. The grid is shared by all timers, so deadlines with overlapping tolerance
+        // windows end up on the same instant and fire in one wakeup.
+        std::chrono::steady_clock::time_point AlignDeadline(std::chrono::steady_clock::time_point deadline,
+                                                            std::chrono::nanoseconds tolerance) {
+            if (tolerance.count() <= 1) {
+                return deadline;
+            }
+
+            int64_t grid = 1;
+            while (grid <= tolerance.count() / 2) {
+                grid <<= 1;
+            }
+
+            int64_t sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+            int64_t remainder = sinceEpoch % grid;
+            if (remainder == 0) {
+                return deadline;
+            }
+            return deadline + std::chrono::nanoseconds(grid - remainder);
+        }
+
+        // IntervalState::phase of non-overlapping intervals
+        enum IntervalPhase : uint32_t {
+            IntervalIdle = 0,
+            IntervalRunning = 1,
+            IntervalRunningWithPending = 2
+        };
+
+    } // namespace
+
+    EventLoop::EventLoop(TimerBackend timerBackend)
+        : EventLoop([timerBackend]() {
+              EventLoopSpecification specification;
+              specification.Timers = timerBackend;
+              return specification;
+          }())
     {
-        // Initialize thread pool (4 threads for parallel execution)
-        const size_t numThreads = std::max(2u, std::thread::hardware_concurrency());
-        
-        for (size_t i = 0; i < numThreads; ++i) {
-            m_ThreadPool.emplace_back([this]() {
-                while (true) {
-                    std::function<void()> task;
-                    
-                    {
-                        std::unique_lock<std::mutex> lock(m_TaskMutex);
-                        m_TaskCondition.wait(lock, [this] { return !m_TaskQueue.empty() || m_StopThreads.load(); });
-                        
-                        if (m_StopThreads.load() && m_TaskQueue.empty()) {
-                            break;
-                        }
-                        
-                        if (!m_TaskQueue.empty()) {
-                            task = std::move(m_TaskQueue.front());
-                            m_TaskQueue.pop();
-                        }
-                    }
-                    
-                    if (task) {
-                        try {
-                            task();
-                        } catch (const std::exception& e) {
-                            std::cerr << "EventLoop: Exception in callback: " << e.what() << std::endl;
-                        } catch (...) {
-                            std::cerr << "EventLoop: Unknown exception in callback" << std::endl;
-                        }
-                    }
-                }
-            });
+    }
+
+    EventLoop::EventLoop(const EventLoopSpecification& specification)
+        : m_TimerBackend(specification.Timers), m_TimerDeadlines(specification.TimerDeadlines),
+          m_Immediates(WALRUS_EVENT_LOOP_IMMEDIATE_POOL_CAPACITY),
+          m_ThreadPool(specification.Workers), m_TaskLimit(specification.TaskLimit),
+          m_TimerLimit(specification.TimerLimit), m_Poller(CreateEventPoller())
+    {
+        if (m_TimerBackend == TimerBackend::Wheel) {
+            m_TimerQueue = std::make_unique<TimerWheel>();
+        } else {
+            m_TimerQueue = std::make_unique<TimerHeap>();
         }
+
+        // Preallocate event records so steady-state scheduling does not allocate
+        m_TimerQueue->Reserve(WALRUS_EVENT_LOOP_TIMER_POOL_CAPACITY);
+        m_FiredTimers[TaskLane(TaskPriority::Normal)].reserve(WALRUS_EVENT_LOOP_TIMER_POOL_CAPACITY);
+        m_ReadyImmediates[TaskLane(TaskPriority::Normal)].reserve(WALRUS_EVENT_LOOP_IMMEDIATE_POOL_CAPACITY);
     }
 
     EventLoop::~EventLoop() {
@@ -58,8 +84,14 @@ namespace Walrus {
         }
         
         m_Running.store(true);
+        m_ThreadPool.Start();
         m_EventThread = std::thread(&EventLoop::EventLoopThread, this);
-        std::cout << "EventLoop: Started with " << m_ThreadPool.size() << " worker threads" << std::endl;
+
+        std::cout << "EventLoop: Started with " << m_ThreadPool.GetThreadCount();
+        if (m_ThreadPool.GetThreadCount() != m_ThreadPool.GetMaxThreadCount()) {
+            std::cout << " (up to " << m_ThreadPool.GetMaxThreadCount() << ")";
+        }
+        std::cout << " worker threads (" << m_Poller->GetName() << ")" << std::endl;
     }
 
     void EventLoop::Stop() {
@@ -68,171 +100,693 @@ namespace Walrus {
         }
         
         m_Running.store(false);
-        m_EventCondition.notify_all();
+        m_Poller->Notify();
+        {
+            std::lock_guard<std::mutex> lock(m_TimerMutex);
+            m_TimerRoom.notify_all(); // Submitters blocked by TimerLimit give up
+        }
         
         if (m_EventThread.joinable()) {
             m_EventThread.join();
         }
         
-        // Stop thread pool
-        m_StopThreads.store(true);
-        m_TaskCondition.notify_all();
-        
-        for (auto& thread : m_ThreadPool) {
-            if (thread.joinable()) {
-                thread.join();
-            }
-        }
+        // Stop thread pool (runs the callbacks that are already queued)
+        m_ThreadPool.Shutdown();
         
         std::cout << "EventLoop: Stopped" << std::endl;
     }
 
     EventId EventLoop::SetTimeout(EventCallback callback, int milliseconds) {
-        EventId id = GenerateId();
-        auto now = std::chrono::steady_clock::now();
-        auto executionTime = now + std::chrono::milliseconds(milliseconds);
-        
-        auto timerEvent = std::make_shared<TimerEvent>(id, std::move(callback), executionTime, std::chrono::milliseconds(0), false);
-        
-        {
+        return AddTimer(std::move(callback), nullptr, std::chrono::milliseconds(milliseconds), false, TimerSpecification());
+    }
+
+    EventId EventLoop::SetTimeout(EventCallback callback, int milliseconds, const TimerSpecification& specification) {
+        return AddTimer(std::move(callback), nullptr, std::chrono::milliseconds(milliseconds), false, specification);
+    }
+
+    EventId EventLoop::SetInterval(EventCallback callback, int milliseconds) {
+        return AddTimer(std::move(callback), nullptr, std::chrono::milliseconds(milliseconds), true, TimerSpecification());
+    }
+
+    EventId EventLoop::SetInterval(EventCallback callback, int milliseconds, const TimerSpecification& specification) {
+        return AddTimer(std::move(callback), nullptr, std::chrono::milliseconds(milliseconds), true, specification);
+    }
+
+    EventId EventLoop::SetInterval(IntervalCallback callback, int milliseconds, const TimerSpecification& specification) {
+        return AddTimer(nullptr, std::move(callback), std::chrono::milliseconds(milliseconds), true, specification);
+    }
+
+    EventId EventLoop::AddTimer(EventCallback callback, IntervalCallback tickCallback, std::chrono::nanoseconds delay, bool repeat,
+                                const TimerSpecification& specification, bool limited) {
+        // Under a timer limit the slot is taken when the timer is admitted, not when it is pushed
+        const bool reserved = limited && m_TimerLimit.Capacity > 0;
+        if (reserved && !AdmitTimer()) {
+            return 0;
+        }
+
+        EventId id;
+        std::chrono::steady_clock::time_point executionTime;
+        try {
+            TimerEvent timerEvent = MakeTimer(std::move(callback), std::move(tickCallback), delay, repeat, specification,
+                                              std::chrono::steady_clock::now());
+            executionTime = timerEvent.nextExecution;
+
             std::lock_guard<std::mutex> lock(m_TimerMutex);
-            m_TimerQueue.push(timerEvent);
-            m_TimerMap[id] = timerEvent;
+            id = m_TimerQueue->Push(std::move(timerEvent));
+            if (!reserved) {
+                m_LiveTimers++;
+            }
+        } catch (...) {
+            if (reserved) {
+                std::lock_guard<std::mutex> lock(m_TimerMutex);
+                ReleaseTimer();
+            }
+            throw;
         }
-        
-        m_EventCondition.notify_one();
+
+
+        Wakeup(executionTime);
         return id;
     }
 
-    EventId EventLoop::SetInterval(EventCallback callback, int milliseconds) {
-        EventId id = GenerateId();
+    void EventLoop::SetTimeoutBatch(std::vector<TimerRequest>& timers, std::vector<EventId>* ids) {
+        if (ids) {
+            ids->resize(timers.size());
+        }
+        if (timers.empty()) {
+            return;
+        }
+
         auto now = std::chrono::steady_clock::now();
-        auto executionTime = now + std::chrono::milliseconds(milliseconds);
-        
-        auto timerEvent = std::make_shared<TimerEvent>(id, std::move(callback), executionTime, std::chrono::milliseconds(milliseconds), true);
-        
+        auto earliest = std::chrono::steady_clock::time_point::max();
+        size_t admitted = timers.size();
         {
             std::lock_guard<std::mutex> lock(m_TimerMutex);
-            m_TimerQueue.push(timerEvent);
-            m_TimerMap[id] = timerEvent;
+            if (m_TimerLimit.Capacity > 0) {
+                admitted = std::min(admitted, m_TimerLimit.Capacity - std::min(m_TimerLimit.Capacity, m_LiveTimers));
+            }
+
+            for (size_t i = 0; i < admitted; ++i) {
+                TimerRequest& request = timers[i];
+                TimerEvent timerEvent = MakeTimer(std::move(request.Callback), nullptr, request.Delay, false,
+                                                  request.Specification, now);
+                earliest = std::min(earliest, timerEvent.nextExecution);
+
+                EventId id = m_TimerQueue->Push(std::move(timerEvent));
+                if (ids) {
+                    (*ids)[i] = id;
+                }
+            }
+            m_LiveTimers += admitted;
         }
-        
-        m_EventCondition.notify_one();
-        return id;
+        if (admitted > 0) {
+            Wakeup(earliest);
+        }
+
+        // The rest did not fit under the timer limit, its policy decides one by one
+        for (size_t i = admitted; i < timers.size(); ++i) {
+            TimerRequest& request = timers[i];
+            EventId id = AddTimer(std::move(request.Callback), nullptr, request.Delay, false, request.Specification);
+            if (ids) {
+                (*ids)[i] = id;
+            }
+        }
+        timers.clear();
     }
 
-    EventId EventLoop::SetImmediate(EventCallback callback) {
-        EventId id = GenerateId();
-        auto immediateEvent = std::make_shared<ImmediateEvent>(id, std::move(callback));
-        
+    TimerEvent EventLoop::MakeTimer(EventCallback callback, IntervalCallback tickCallback, std::chrono::nanoseconds delay,
+                                    bool repeat, const TimerSpecification& specification,
+                                    std::chrono::steady_clock::time_point now) {
+        auto scheduled = now + delay;
+        auto executionTime = AlignDeadline(scheduled, specification.Tolerance);
+        auto interval = repeat ? delay : std::chrono::nanoseconds(0);
+
+        TimerEvent timerEvent(0, std::move(callback), executionTime, interval, repeat);
+        if (repeat) {
+            // Intervals keep one shared callback that every fired tick points at
+            if (!tickCallback) {
+                tickCallback = [callback = std::move(timerEvent.callback)](uint64_t) { callback(); };
+            }
+            timerEvent.intervalState = std::make_shared<IntervalState>(std::move(tickCallback));
+            timerEvent.intervalState->nonOverlapping = specification.NonOverlapping;
+            timerEvent.intervalState->reportMissed = specification.Policy == IntervalPolicy::Coalesce;
+        }
+        timerEvent.scheduled = scheduled;
+        timerEvent.tolerance = specification.Tolerance;
+        timerEvent.policy = specification.Policy;
+        timerEvent.maxCatchUpCalls = std::max<uint32_t>(specification.MaxCatchUpCalls, 1);
+        timerEvent.priority = specification.Priority;
+        timerEvent.deadline = specification.Deadline;
+        return timerEvent;
+    }
+
+    bool EventLoop::Post(EventCallback callback, TaskPriority priority) {
+        switch (AdmitTask()) {
+            case Admission::Refuse: return false;
+            case Admission::RunInCaller: RunInCaller(callback); return true;
+            case Admission::Queue: break;
+        }
+
+        m_ThreadPool.Submit(Track(std::move(callback)), priority);
+        return true;
+    }
+
+    void EventLoop::PostContinuation(EventCallback callback, TaskPriority priority) {
+        m_ThreadPool.Submit(std::move(callback), priority);
+    }
+
+    void EventLoop::PostContinuation(std::vector<EventCallback>& callbacks, TaskPriority priority) {
+        m_ThreadPool.Submit(callbacks, priority);
+    }
+
+    size_t EventLoop::PostBulk(std::vector<EventCallback>& callbacks, TaskPriority priority) {
+        const size_t count = callbacks.size();
+        if (m_TaskLimit.Capacity == 0) {
+            m_ThreadPool.Submit(callbacks, priority);
+            return count;
+        }
+
+        // Queue what fits as one batch, the rest goes through the policy one by one
+        const size_t room = m_TaskLimit.Capacity - std::min(m_TaskLimit.Capacity, TaskBacklog());
+        std::vector<EventCallback> rest;
+        for (size_t i = room; i < count; ++i) {
+            rest.push_back(std::move(callbacks[i]));
+        }
+        callbacks.resize(std::min(room, count));
+        for (auto& callback : callbacks) {
+            callback = Track(std::move(callback));
+        }
+        m_ThreadPool.Submit(callbacks, priority);
+
+        size_t accepted = count - rest.size();
+        for (auto& callback : rest) {
+            accepted += Post(std::move(callback), priority) ? 1 : 0;
+        }
+        return accepted;
+    }
+
+    bool EventLoop::PostWithDeadline(EventCallback callback, std::chrono::steady_clock::time_point deadline,
+                                     TaskPriority priority) {
+        switch (AdmitTask()) {
+            case Admission::Refuse: return false;
+            case Admission::RunInCaller: RunInCaller(callback); return true;
+            case Admission::Queue: break;
+        }
+
+        m_ThreadPool.Submit(DeadlineTask{ Track(std::move(callback)), deadline }, priority);
+        return true;
+    }
+
+    void EventLoop::SetImmediateBatch(std::vector<EventCallback>& callbacks, std::vector<EventId>* ids, TaskPriority priority) {
+        if (ids) {
+            ids->resize(callbacks.size());
+        }
+        if (callbacks.empty()) {
+            return;
+        }
+
+        size_t admitted = callbacks.size();
+        if (m_TaskLimit.Capacity > 0) {
+            admitted = std::min(admitted, m_TaskLimit.Capacity - std::min(m_TaskLimit.Capacity, TaskBacklog()));
+        }
+
+        auto produce = [this, &callbacks, priority](size_t i) { return ImmediateTask{ Track(std::move(callbacks[i])), priority }; };
+        m_Immediates.PushBulk(admitted, produce, [ids](size_t i, uint32_t index, uint32_t generation) {
+            if (ids) {
+                (*ids)[i] = MakeEventId(index, generation, true);
+            }
+        });
+        if (admitted > 0) {
+            SignalImmediates();
+        }
+
+        // The rest did not fit under the task limit, its policy decides one by one
+        for (size_t i = admitted; i < callbacks.size(); ++i) {
+            EventId id = SetImmediate(std::move(callbacks[i]), priority);
+            if (ids) {
+                (*ids)[i] = id;
+            }
+        }
+        callbacks.clear();
+    }
+
+    EventId EventLoop::SetImmediate(EventCallback callback, TaskPriority priority) {
+        switch (AdmitTask()) {
+            case Admission::Refuse: return 0;
+            case Admission::RunInCaller: RunInCaller(callback); return 0;
+            case Admission::Queue: break;
+        }
+
+        uint32_t generation;
+        const uint32_t index = m_Immediates.Push({ Track(std::move(callback)), priority }, generation);
+
+        SignalImmediates();
+        return MakeEventId(index, generation, true);
+    }
+
+    size_t EventLoop::TaskBacklog() const {
+        const size_t queued = m_ThreadPool.GetPendingCount() + m_Immediates.Size();
+        return queued - std::min(queued, m_DroppedQueued.load(std::memory_order_relaxed));
+    }
+
+    bool EventLoop::InLoopOrWorkerThread() const {
+        return std::this_thread::get_id() == m_EventThread.get_id() || IsWorkerThread();
+    }
+
+    EventLoop::Admission EventLoop::AdmitTask() {
+        if (m_TaskLimit.Capacity == 0 || TaskBacklog() < m_TaskLimit.Capacity) {
+            return Admission::Queue;
+        }
+
+        switch (m_TaskLimit.Policy) {
+            case OverflowPolicy::Block:
+                if (InLoopOrWorkerThread()) {
+                    m_TaskOverflow.ranInCaller++; // Waiting here would hold up the queue it waits on
+                    return Admission::RunInCaller;
+                }
+                // Rechecked each time a worker takes a task; Stop() shuts the pool down, which wakes us too
+                m_ThreadPool.WaitForTaken([this]() {
+                    return !m_Running.load() || TaskBacklog() < m_TaskLimit.Capacity;
+                });
+                if (!m_Running.load()) { // A stopped pool drains nothing
+                    m_TaskOverflow.rejected++;
+                    return Admission::Refuse;
+                }
+                m_TaskOverflow.blocked++;
+                return Admission::Queue;
+
+            case OverflowPolicy::RunInCaller:
+                m_TaskOverflow.ranInCaller++;
+                return Admission::RunInCaller;
+
+            case OverflowPolicy::DropOldest:
+                if (DropOldestTask()) {
+                    m_TaskOverflow.droppedOldest++;
+                    return Admission::Queue;
+                }
+                break; // Nothing droppable is queued
+
+            case OverflowPolicy::Reject:
+                break;
+        }
+
+        m_TaskOverflow.rejected++;
+        return Admission::Refuse;
+    }
+
+    bool EventLoop::AdmitTimer() {
+        // Check and reserve under one lock, so concurrent callers cannot all take the last slot
+        std::unique_lock<std::mutex> lock(m_TimerMutex);
+        if (m_LiveTimers < m_TimerLimit.Capacity) {
+            m_LiveTimers++;
+            return true;
+        }
+
+        // Timers only ever block: running one early or dropping an armed one would break its schedule
+        if (m_TimerLimit.Policy == OverflowPolicy::Block && !InLoopOrWorkerThread()) {
+            m_TimerRoomWaiters++;
+            m_TimerRoom.wait(lock, [this]() { return !m_Running.load() || m_LiveTimers < m_TimerLimit.Capacity; });
+            m_TimerRoomWaiters--;
+            if (m_Running.load()) {
+                m_LiveTimers++;
+                m_TimerOverflow.blocked++;
+                return true;
+            }
+        }
+
+        m_TimerOverflow.rejected++;
+        return false;
+    }
+
+    void EventLoop::ReleaseTimer() {
+        // Caller holds m_TimerMutex
+        m_LiveTimers--;
+        if (m_TimerRoomWaiters != 0) {
+            m_TimerRoom.notify_one();
+        }
+    }
+
+    EventCallback EventLoop::Track(EventCallback callback) {
+        if (m_TaskLimit.Capacity == 0 || m_TaskLimit.Policy != OverflowPolicy::DropOldest) {
+            return callback;
+        }
+
+        auto task = std::make_shared<DroppableTask>();
+        task->callback = std::move(callback);
         {
-            std::lock_guard<std::mutex> lock(m_ImmediateMutex);
-            m_ImmediateQueue.push(immediateEvent);
-            m_ImmediateMap[id] = immediateEvent;
+            std::lock_guard<std::mutex> lock(m_DroppableMutex);
+            while (!m_Droppable.empty() && m_Droppable.front()->state.load() != DroppableTask::Queued) {
+                m_Droppable.pop_front(); // Started, nothing left to drop there
+            }
+            // Pool order is not submission order: a long-queued front can hide started tasks behind it
+            if (m_Droppable.size() > 2 * m_TaskLimit.Capacity) {
+                m_Droppable.erase(std::remove_if(m_Droppable.begin(), m_Droppable.end(), [](const auto& queued) {
+                    return queued->state.load() != DroppableTask::Queued;
+                }), m_Droppable.end());
+            }
+            m_Droppable.push_back(task);
         }
-        
-        m_EventCondition.notify_one();
-        return id;
+
+        return [this, task]() {
+            uint8_t expected = DroppableTask::Queued;
+            if (task->state.compare_exchange_strong(expected, DroppableTask::Started)) {
+                EventCallback callback = std::move(task->callback);
+                callback();
+            } else {
+                m_DroppedQueued.fetch_sub(1);
+            }
+        };
     }
 
-    void EventLoop::ClearInterval(EventId id) {
-        // Mark timer event as cancelled
+    bool EventLoop::DropOldestTask() {
+        // Counted before the claim, so a racing pool entry never takes the counter below zero
+        m_DroppedQueued.fetch_add(1);
+
+        std::shared_ptr<DroppableTask> victim;
         {
+            std::lock_guard<std::mutex> lock(m_DroppableMutex);
+            while (!victim && !m_Droppable.empty()) {
+                std::shared_ptr<DroppableTask> task = std::move(m_Droppable.front());
+                m_Droppable.pop_front();
+
+                uint8_t expected = DroppableTask::Queued;
+                if (task->state.compare_exchange_strong(expected, DroppableTask::Dropped)) {
+                    victim = std::move(task);
+                }
+            }
+        }
+
+        if (!victim) {
+            m_DroppedQueued.fetch_sub(1);
+            return false;
+        }
+        victim->callback = nullptr; // Free the captures now, the pool entry runs later as a no-op
+        return true;
+    }
+
+    void EventLoop::RunInCaller(EventCallback& callback) {
+        try {
+            callback();
+        } catch (const std::exception& e) {
+            std::cerr << "EventLoop: Exception in callback: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "EventLoop: Unknown exception in callback" << std::endl;
+        }
+    }
+
+    OverflowStats EventLoop::OverflowCounters::Load() const {
+        OverflowStats stats;
+        stats.Blocked = blocked.load(std::memory_order_relaxed);
+        stats.Rejected = rejected.load(std::memory_order_relaxed);
+        stats.RanInCaller = ranInCaller.load(std::memory_order_relaxed);
+        stats.DroppedOldest = droppedOldest.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void EventLoop::ClearInterval(EventId id) {
+        // No wakeup needed: cancelling can only move the earliest deadline later, so at worst
+        // the sleeping loop thread wakes once at the old deadline and finds nothing to do.
+
+        // The handle says which slab holds the event, stale handles fail the generation check
+        if (!IsImmediateEventId(id)) {
             std::lock_guard<std::mutex> lock(m_TimerMutex);
-            auto it = m_TimerMap.find(id);
-            if (it != m_TimerMap.end()) {
-                it->second->cancelled = true;
-                m_TimerMap.erase(it);
-                return;
+            if (m_TimerQueue->Cancel(id)) {
+                ReleaseTimer();
             }
+            return;
         }
-        
-        // Mark immediate event as cancelled
+
+        // Mark immediate event as cancelled; the record stays queued until the loop thread pops and recycles it
+        m_Immediates.Cancel(EventIdIndex(id), EventIdGeneration(id));
+    }
+
+    void EventLoop::SignalImmediates() {
+        // The load keeps the common case (loop thread already signalled) free of writes to the shared flag
+        if (!m_ImmediatesSignalled.load() && !m_ImmediatesSignalled.exchange(true)) {
+            m_Poller->Notify();
+        }
+    }
+
+    void EventLoop::Wakeup(std::chrono::steady_clock::time_point deadline) {
         {
-            std::lock_guard<std::mutex> lock(m_ImmediateMutex);
-            auto it = m_ImmediateMap.find(id);
-            if (it != m_ImmediateMap.end()) {
-                it->second->cancelled = true;
-                m_ImmediateMap.erase(it);
+            std::lock_guard<std::mutex> lock(m_EventMutex);
+            if (deadline >= m_NextWakeup) {
+                return; // Loop thread is awake or will wake up in time anyway
             }
+            m_NextWakeup = std::chrono::steady_clock::time_point::min(); // One notification is enough
         }
+        m_Poller->Notify();
+    }
+
+    std::chrono::steady_clock::time_point EventLoop::NextWakeupTime() {
+        // Clear the signal before looking at the queue: a push this check misses sees the flag cleared and notifies
+        m_ImmediatesSignalled.store(false);
+        if (m_Immediates.Size() > 0) {
+            return std::chrono::steady_clock::time_point::min();
+        }
+
+        std::lock_guard<std::mutex> lock(m_TimerMutex);
+        return m_TimerQueue->NextDeadline();
     }
 
     void EventLoop::EventLoopThread() {
+#if defined(WL_PLATFORM_LINUX)
+        // The default 50 us timer slack would dominate sub-millisecond timers
+        prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+#endif
+
         while (m_Running.load()) {
             ProcessImmediateEvents();
             ProcessTimerEvents();
             
-            // Wait for next event or timeout
-            std::unique_lock<std::mutex> lock(m_EventMutex);
-            m_EventCondition.wait_for(lock, std::chrono::milliseconds(1), [this] {
-                return !m_Running.load() || 
-                       (!m_ImmediateQueue.empty()) ||
-                       (!m_TimerQueue.empty() && m_TimerQueue.top()->nextExecution <= std::chrono::steady_clock::now());
-            });
+            // Publish the next deadline before sleeping. It is computed under m_EventMutex, so anything
+            // scheduled after this point sees m_NextWakeup and notifies the poller if it is earlier;
+            // a notification that arrives before Wait() makes it return immediately.
+            std::chrono::steady_clock::time_point deadline;
+            {
+                std::lock_guard<std::mutex> lock(m_EventMutex);
+                deadline = NextWakeupTime();
+#if !WALRUS_EVENT_LOOP_TICKLESS
+                deadline = std::min(deadline, std::chrono::steady_clock::now() + std::chrono::milliseconds(1));
+#endif
+                m_NextWakeup = deadline;
+            }
+
+            if (deadline == std::chrono::steady_clock::time_point::max()) {
+                m_Poller->Wait(deadline);
+            } else if (deadline != std::chrono::steady_clock::time_point::min()) {
+                const auto spin = std::chrono::microseconds(WALRUS_EVENT_LOOP_SPIN_US);
+                if (!m_Poller->Wait(deadline - spin) && spin.count() > 0) {
+                    // Yield through the last stretch instead of trusting the kernel to wake us on time.
+                    // m_NextWakeup still holds the deadline, so producers keep notifying: an immediate
+                    // sets m_ImmediatesSignalled and an earlier timer clears m_NextWakeup, either ends the spin.
+                    auto woken = [this]() {
+                        if (m_ImmediatesSignalled.load()) {
+                            return true;
+                        }
+                        std::lock_guard<std::mutex> lock(m_EventMutex);
+                        return m_NextWakeup == std::chrono::steady_clock::time_point::min();
+                    };
+                    while (m_Running.load() && std::chrono::steady_clock::now() < deadline && !woken()) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_EventMutex);
+                m_NextWakeup = std::chrono::steady_clock::time_point::min();
+            }
+            m_WakeupCount.fetch_add(1, std::memory_order_relaxed);
         }
     }
 
     void EventLoop::ProcessTimerEvents() {
         auto now = std::chrono::steady_clock::now();
+        uint64_t expired = 0;
         
-        std::lock_guard<std::mutex> lock(m_TimerMutex);
-        
-        while (!m_TimerQueue.empty() && m_TimerQueue.top()->nextExecution <= now) {
-            auto event = m_TimerQueue.top();
-            m_TimerQueue.pop();
-            
-            if (event->cancelled) {
-                continue;
+        {
+            std::lock_guard<std::mutex> lock(m_TimerMutex);
+
+            m_TimerQueue->ProcessExpired(now, [this, now, &expired](TimerEvent& event) {
+                expired++;
+                return FireTimer(event, now);
+            });
+        }
+
+        if (expired == 0) {
+            return;
+        }
+
+        m_TimerWakeupCount.fetch_add(1, std::memory_order_relaxed);
+        m_TimersFired.fetch_add(expired, std::memory_order_relaxed);
+
+        // Schedule all expired callbacks in the thread pool at once
+        DispatchTasks(m_FiredTimers, &m_FiredDeadlineTimers);
+    }
+
+    bool EventLoop::FireTimer(TimerEvent& event, std::chrono::steady_clock::time_point now) {
+        const auto due = event.nextExecution;
+        if (!event.repeat) {
+            // Timeouts fire once, so hand over the callback instead of copying it
+            QueueFired(event, due, std::move(event.callback));
+            ReleaseTimer();
+            return false;
+        }
+
+        uint64_t missedTicks = 0;
+        if (event.policy == IntervalPolicy::Relative || event.interval.count() <= 0) {
+            event.scheduled = now + event.interval;
+        } else {
+            // Advance the anchored schedule, counting the ticks that are already in the past
+            auto next = event.scheduled + event.interval;
+            if (next <= now) {
+                missedTicks = static_cast<uint64_t>((now - next) / event.interval) + 1;
+                next += event.interval * missedTicks;
             }
-            
-            // Schedule callback execution in thread pool
-            {
-                std::lock_guard<std::mutex> taskLock(m_TaskMutex);
-                m_TaskQueue.push([callback = event->callback]() {
-                    callback();
-                });
+            event.scheduled = next;
+            m_MissedIntervalTicks.fetch_add(missedTicks, std::memory_order_relaxed);
+        }
+        event.nextExecution = AlignDeadline(event.scheduled, event.tolerance);
+
+        // A long stall must not turn into an unbounded burst, the rest of the missed ticks is skipped
+        const uint64_t calls = event.policy == IntervalPolicy::CatchUp
+            ? std::min<uint64_t>(missedTicks + 1, event.maxCatchUpCalls) : 1;
+        const uint64_t reported = event.policy == IntervalPolicy::Coalesce ? missedTicks : 0;
+
+        for (uint64_t i = 0; i < calls; ++i) {
+            if (event.intervalState->nonOverlapping) {
+                FireNonOverlapping(event, due, reported);
+                continue;
             }
-            m_TaskCondition.notify_one();
-            
-            // If it's a repeating interval, reschedule it
-            if (event->repeat && !event->cancelled) {
-                event->nextExecution = now + event->interval;
-                m_TimerQueue.push(event);
+
+            // Only the shared_ptr is copied, the task fits UniqueFunction's inline buffer
+            QueueFired(event, due, [state = event.intervalState, reported]() {
+                state->callback(reported);
+            });
+        }
+        return true;
+    }
+
+    void EventLoop::QueueFired(const TimerEvent& event, std::chrono::steady_clock::time_point due, EventCallback task) {
+        const size_t lane = TaskLane(event.priority);
+        if (event.deadline.count() > 0) {
+            m_FiredDeadlineTimers[lane].push_back({ std::move(task), due + event.deadline, true });
+        } else if (m_TimerDeadlines) {
+            m_FiredDeadlineTimers[lane].push_back({ std::move(task), due, false });
+        } else {
+            m_FiredTimers[lane].push_back(std::move(task));
+        }
+    }
+
+    void EventLoop::FireNonOverlapping(const TimerEvent& event, std::chrono::steady_clock::time_point due,
+                                       uint64_t missedTicks) {
+        const std::shared_ptr<IntervalState>& state = event.intervalState;
+        if (missedTicks > 0) {
+            state->folded.fetch_add(missedTicks);
+        }
+
+        // Only the loop thread raises the phase, the worker running a tick lowers it when it returns
+        uint32_t phase = state->phase.load();
+        while (true) {
+            if (phase == IntervalIdle) {
+                if (state->phase.compare_exchange_weak(phase, IntervalRunning)) {
+                    QueueFired(event, due, [state]() { RunNonOverlapping(state); });
+                    return;
+                }
+            } else if (phase == IntervalRunning) {
+                if (state->phase.compare_exchange_weak(phase, IntervalRunningWithPending)) {
+                    return; // The running tick calls again when it returns
+                }
             } else {
-                // Remove from map if it's a timeout or cancelled
-                m_TimerMap.erase(event->id);
+                state->folded.fetch_add(1);
+                m_SkippedIntervalFires.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    void EventLoop::RunNonOverlapping(const std::shared_ptr<IntervalState>& state) {
+        while (true) {
+            const uint64_t missed = state->folded.exchange(0);
+
+            // The phase must come back down even if the callback throws, or the interval would stall
+            try {
+                state->callback(state->reportMissed ? missed : 0);
+            } catch (const std::exception& e) {
+                std::cerr << "EventLoop: Exception in callback: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "EventLoop: Unknown exception in callback" << std::endl;
             }
+
+            uint32_t phase = IntervalRunning;
+            if (state->phase.compare_exchange_strong(phase, IntervalIdle)) {
+                return;
+            }
+            state->phase.store(IntervalRunning); // Take the pending fire on this worker
         }
     }
 
     void EventLoop::ProcessImmediateEvents() {
-        std::lock_guard<std::mutex> lock(m_ImmediateMutex);
-        
-        while (!m_ImmediateQueue.empty()) {
-            auto event = m_ImmediateQueue.front();
-            m_ImmediateQueue.pop();
-            
-            if (event->cancelled) {
-                continue;
+        // Only what was queued on entry: immediates scheduled meanwhile wait for the next iteration,
+        // so a steady stream of producers cannot keep the loop thread away from its timers
+        size_t budget = m_Immediates.Size();
+        ImmediateTask immediate;
+        while (budget-- > 0 && m_Immediates.Pop(immediate)) {
+            m_ReadyImmediates[TaskLane(immediate.priority)].push_back(std::move(immediate.callback));
+        }
+
+        DispatchTasks(m_ReadyImmediates);
+    }
+
+    void EventLoop::DispatchTasks(LaneTasks& tasks, LaneDeadlineTasks* deadlineTasks) {
+        // Most urgent lane first, so its workers are woken before the others are queued
+        for (size_t lane = 0; lane < TaskPriorityCount; ++lane) {
+            if (deadlineTasks && !(*deadlineTasks)[lane].empty()) {
+                m_ThreadPool.Submit((*deadlineTasks)[lane], static_cast<TaskPriority>(lane));
             }
-            
-            // Schedule callback execution in thread pool
-            {
-                std::lock_guard<std::mutex> taskLock(m_TaskMutex);
-                m_TaskQueue.push([callback = event->callback]() {
-                    callback();
-                });
+            if (!tasks[lane].empty()) {
+                m_ThreadPool.Submit(tasks[lane], static_cast<TaskPriority>(lane));
             }
-            m_TaskCondition.notify_one();
-            
-            // Remove from map
-            m_ImmediateMap.erase(event->id);
         }
     }
 
-    EventId EventLoop::GenerateId() {
-        return m_NextId.fetch_add(1);
+    EventLoopStats EventLoop::GetStats() const {
+        EventLoopStats stats;
+        stats.Wakeups = m_WakeupCount.load(std::memory_order_relaxed);
+        stats.TimerWakeups = m_TimerWakeupCount.load(std::memory_order_relaxed);
+        stats.TimersFired = m_TimersFired.load(std::memory_order_relaxed);
+        stats.WakeupsSaved = stats.TimersFired - stats.TimerWakeups;
+        stats.MissedIntervalTicks = m_MissedIntervalTicks.load(std::memory_order_relaxed);
+        stats.SkippedIntervalFires = m_SkippedIntervalFires.load(std::memory_order_relaxed);
+        stats.TasksExecuted = m_ThreadPool.GetTasksExecuted();
+        stats.TasksStolen = m_ThreadPool.GetTasksStolen();
+        stats.Workers = m_ThreadPool.GetThreadCount();
+        stats.WorkersAdded = m_ThreadPool.GetWorkersAdded();
+        stats.WorkersRetired = m_ThreadPool.GetWorkersRetired();
+
+        const DeadlineStats deadlines = m_ThreadPool.GetDeadlineStats();
+        stats.DeadlineTasks = deadlines.Completed;
+        stats.DeadlineMisses = deadlines.Missed;
+        stats.MaxDeadlineLateness = deadlines.MaxLateness;
+
+        std::unique_lock<std::mutex> lock(m_TimerMutex);
+        stats.LiveTimers = m_LiveTimers;
+        stats.TimerEntries = m_TimerQueue->Size();
+        stats.DeadTimerEntries = stats.TimerEntries - std::min(stats.TimerEntries, stats.LiveTimers);
+        stats.TimerPoolHighWater = m_TimerQueue->HighWater();
+        lock.unlock();
+
+        stats.ImmediatePoolHighWater = m_Immediates.HighWater();
+        stats.ImmediatePoolCapacity = m_Immediates.Capacity();
+
+        for (size_t lane = 0; lane < TaskPriorityCount; ++lane) {
+            stats.Lanes[lane] = m_ThreadPool.GetLaneStats(static_cast<TaskPriority>(lane));
+        }
+
+        stats.TaskOverflow = m_TaskOverflow.Load();
+        stats.TimerOverflow = m_TimerOverflow.Load();
+        return stats;
     }
 
 } // namespace Walrus
@@ -5,46 +5,149 @@
 
 #if WALRUS_ENABLE_EVENT_LOOP
 
+#include "TimerQueue.h"
+#include "EventPoller.h"
+#include "MpscQueue.h"
+#include "ThreadPool.h"
+
 #include <functional>
 #include <chrono>
 #include <thread>
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
-#include <queue>
-#include <unordered_map>
+#include <deque>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace Walrus {
 
-    using EventCallback = std::function<void()>;
-    using EventId = uint64_t;
+    template<typename T>
+    class Future;
+
+#if WALRUS_ENABLE_COROUTINES
+    struct DelayAwaiter;
+    struct ScheduleAwaiter;
+#endif
+
+    // Optional per-timer settings for SetTimeout/SetInterval
+    struct TimerSpecification {
+        // How late the timer may fire (0..Tolerance after its deadline). Timers with a tolerance
+        // are aligned to a shared time grid so nearby expirations are handled by one wakeup.
+        std::chrono::nanoseconds Tolerance{0};
+
+        // Interval scheduling. Anchored policies advance the schedule by exactly one interval
+        // per tick, so the cadence does not drift with loop latency.
+        IntervalPolicy Policy = IntervalPolicy::Relative;
+
+        // IntervalPolicy::CatchUp only: the most calls one late tick delivers, counting its own. Missed
+        // ticks beyond it are dropped as under Skip; EventLoopStats::MissedIntervalTicks counts them all.
+        uint32_t MaxCatchUpCalls = WALRUS_EVENT_LOOP_MAX_CATCH_UP_CALLS;
+
+        // Intervals only: never run two ticks at once and never queue more than one. A fire that comes
+        // while a tick runs is held until it returns; further fires are dropped and counted in
+        // EventLoopStats::SkippedIntervalFires (and reported to the next call under Coalesce).
+        bool NonOverlapping = false;
+
+        // Thread pool lane the callback runs in
+        TaskPriority Priority = TaskPriority::Normal;
+
+        // Completion budget after each due time, 0 = none. The callback then runs before the other
+        // tasks of its lane, earliest deadline first, and finishing late counts as a deadline miss.
+        std::chrono::nanoseconds Deadline{0};
+    };
+
+    // What a submission does when the queue it goes to is full (see QueueLimit)
+    enum class OverflowPolicy : uint8_t {
+        Block,       // Wait for room. The loop thread and pool workers cannot wait for their own queue:
+                     // tasks they submit run in the caller, timers they arm are rejected.
+        Reject,      // Refuse it: SetImmediate/SetTimeout/SetInterval return 0, Post returns false
+        RunInCaller, // Run the task on the submitting thread right away (timers: rejected)
+        DropOldest   // Discard the oldest queued task submitted under this policy (timers: rejected)
+    };
+
+    // Capacity of an EventLoop queue and what happens to submissions that find it full
+    struct QueueLimit {
+        size_t Capacity = 0; // 0 = unbounded
+        OverflowPolicy Policy = OverflowPolicy::Reject;
+    };
 
-    struct TimerEvent {
-        EventId id;
-        EventCallback callback;
-        std::chrono::steady_clock::time_point nextExecution;
-        std::chrono::milliseconds interval;
-        bool repeat;
-        bool cancelled;
-
-        TimerEvent(EventId id, EventCallback cb, std::chrono::steady_clock::time_point next, 
-                  std::chrono::milliseconds interval = std::chrono::milliseconds(0), bool repeat = false)
-            : id(id), callback(std::move(cb)), nextExecution(next), interval(interval), repeat(repeat), cancelled(false) {}
+    // Outcomes of submissions that found a full queue
+    struct OverflowStats {
+        uint64_t Blocked = 0;       // Waited for room, then queued
+        uint64_t Rejected = 0;
+        uint64_t RanInCaller = 0;
+        uint64_t DroppedOldest = 0; // Queued tasks discarded to make room for newer ones
     };
 
-    struct ImmediateEvent {
-        EventId id;
-        EventCallback callback;
-        bool cancelled;
+    // Runtime configuration of an EventLoop, settable through ApplicationSpecification::EventLoop.
+    // No thread is created before Start().
+    struct EventLoopSpecification {
+        TimerBackend Timers = static_cast<TimerBackend>(WALRUS_EVENT_LOOP_TIMER_BACKEND);
 
-        ImmediateEvent(EventId id, EventCallback cb)
-            : id(id), callback(std::move(cb)), cancelled(false) {}
+        // Worker threads that run the callbacks (count, lazy creation, min/max, stack size)
+        ThreadPoolSpecification Workers = { WALRUS_EVENT_LOOP_THREAD_COUNT };
+
+        // Earliest-deadline-first for every timer: fired callbacks use their due time as deadline, so
+        // a saturated pool runs the most overdue timer first instead of following submission order.
+        // These deadlines only order the work; misses are counted for explicit deadlines only.
+        bool TimerDeadlines = false;
+
+        // Backpressure. TaskLimit bounds the callbacks waiting to run: immediates not yet dispatched
+        // plus everything queued in the pool. SetImmediate, Post, PostWithDeadline, Submit and the
+        // batch variants are checked against it. Fired timers and continuations (PostContinuation:
+        // strands, task graphs, task groups, futures, Parallel.h helpers) count too but are never
+        // refused. TaskLimit is a soft limit: a submission checks the backlog and then queues without
+        // reserving room, so submitters racing each other (a whole batch each, or Block callers woken
+        // together) can overshoot Capacity by what they queue at once.
+        // TimerLimit bounds the armed timers exactly.
+        QueueLimit TaskLimit;
+        QueueLimit TimerLimit;
+    };
+
+    // One timeout for SetTimeoutBatch
+    struct TimerRequest {
+        EventCallback Callback;
+        std::chrono::nanoseconds Delay{0};
+        TimerSpecification Specification;
+    };
+
+    // Counters describing the work done by the loop thread
+    struct EventLoopStats {
+        uint64_t Wakeups = 0;          // Times the loop thread woke up
+        uint64_t TimerWakeups = 0;     // Wakeups that fired at least one timer
+        uint64_t TimersFired = 0;      // Timer callbacks dispatched to the thread pool
+        uint64_t WakeupsSaved = 0;     // Timers that fired together with another one (TimersFired - TimerWakeups)
+        uint64_t MissedIntervalTicks = 0; // Anchored interval ticks that were late by a full period or more
+        uint64_t SkippedIntervalFires = 0; // Non-overlapping interval fires dropped because one was already pending
+        uint64_t TasksExecuted = 0;    // Callbacks run by the thread pool
+        uint64_t TasksStolen = 0;      // Callbacks a worker took from another worker's queue
+        size_t Workers = 0;            // Worker threads running now
+        uint64_t WorkersAdded = 0;     // Workers launched on demand after Start() (lazy and adaptive pools)
+        uint64_t WorkersRetired = 0;   // Idle workers an adaptive pool let go
+        uint64_t DeadlineTasks = 0;    // Completed callbacks that had an explicit deadline
+        uint64_t DeadlineMisses = 0;   // Those that completed after it
+        std::chrono::nanoseconds MaxDeadlineLateness{0};
+
+        size_t LiveTimers = 0;         // Armed timers that have not completed or been cancelled
+        size_t TimerEntries = 0;       // Entries held by the timer backend
+        size_t DeadTimerEntries = 0;   // Entries kept alive for timers that are no longer live
+
+        size_t TimerPoolHighWater = 0;     // Most timer records in use at once
+        size_t ImmediatePoolHighWater = 0; // Most immediate records in use at once
+        size_t ImmediatePoolCapacity = 0;  // Immediate records allocated (pools never shrink)
+
+        TaskLaneStats Lanes[TaskPriorityCount]; // Queue depth and wait times, indexed by TaskLane(priority)
+
+        OverflowStats TaskOverflow;    // Submissions that found EventLoopSpecification::TaskLimit reached
+        OverflowStats TimerOverflow;   // Same for TimerLimit
     };
 
     class EventLoop {
     public:
-        EventLoop();
+        explicit EventLoop(const EventLoopSpecification& specification);
+        explicit EventLoop(TimerBackend timerBackend = static_cast<TimerBackend>(WALRUS_EVENT_LOOP_TIMER_BACKEND));
         ~EventLoop();
 
         // Start the event loop (called automatically by Application)
@@ -55,55 +158,220 @@ namespace Walrus {
 
         // SetTimeout - execute callback once after delay
         EventId SetTimeout(EventCallback callback, int milliseconds);
+        EventId SetTimeout(EventCallback callback, int milliseconds, const TimerSpecification& specification);
+
+        template<typename Rep, typename Period>
+        EventId SetTimeout(EventCallback callback, std::chrono::duration<Rep, Period> delay,
+                           const TimerSpecification& specification = TimerSpecification()) {
+            return AddTimer(std::move(callback), nullptr, ToNanoseconds(delay), false, specification);
+        }
         
         // SetInterval - execute callback repeatedly with interval
         EventId SetInterval(EventCallback callback, int milliseconds);
+        EventId SetInterval(EventCallback callback, int milliseconds, const TimerSpecification& specification);
+        EventId SetInterval(IntervalCallback callback, int milliseconds, const TimerSpecification& specification);
+
+        template<typename Rep, typename Period>
+        EventId SetInterval(EventCallback callback, std::chrono::duration<Rep, Period> interval,
+                            const TimerSpecification& specification = TimerSpecification()) {
+            return AddTimer(std::move(callback), nullptr, ToNanoseconds(interval), true, specification);
+        }
+
+        template<typename Rep, typename Period>
+        EventId SetInterval(IntervalCallback callback, std::chrono::duration<Rep, Period> interval,
+                            const TimerSpecification& specification = TimerSpecification()) {
+            return AddTimer(nullptr, std::move(callback), ToNanoseconds(interval), true, specification);
+        }
         
         // SetImmediate - execute callback as soon as possible in next event loop iteration
-        EventId SetImmediate(EventCallback callback);
+        // Lock-free: concurrent callers do not block each other or the loop thread
+        // Returns 0 if the task limit refused the callback or ran it in the caller
+        EventId SetImmediate(EventCallback callback, TaskPriority priority = TaskPriority::Normal);
+
+        // Post - hand callback straight to the thread pool, bypassing the loop thread. Not cancellable.
+        // Called from a worker a normal task goes to that worker's own queue, so fan-out stays local.
+        // Returns false if the task limit refused the callback.
+        bool Post(EventCallback callback, TaskPriority priority = TaskPriority::Normal);
+
+        // Post for work that continues a task already accepted: exempt from the task limit and never
+        // dropped, so executors built on the pool (strands, task graphs, ...) cannot lose a step
+        void PostContinuation(EventCallback callback, TaskPriority priority = TaskPriority::Normal);
+        void PostContinuation(std::vector<EventCallback>& callbacks, TaskPriority priority = TaskPriority::Normal);
+
+        // Batch variants: one synchronization for the whole batch and at most one wakeup of the loop
+        // thread; the workers are woken once for as many tasks as there are. The callbacks are moved
+        // out and the vector is cleared. If ids is given it receives the IDs in the same order.
+        // Callbacks beyond the room left under the task limit go through its policy one by one;
+        // those get ID 0, and PostBulk returns how many callbacks were not refused.
+        void SetImmediateBatch(std::vector<EventCallback>& callbacks, std::vector<EventId>* ids = nullptr,
+                               TaskPriority priority = TaskPriority::Normal);
+        size_t PostBulk(std::vector<EventCallback>& callbacks, TaskPriority priority = TaskPriority::Normal);
+
+        // Submit - run function on the thread pool and return a Future of its result (see Future.h,
+        // which must be included to call it). Continuations attached with Future::Then run on this pool.
+        template<typename Function>
+        auto Submit(Function&& function, TaskPriority priority = TaskPriority::Normal)
+            -> Future<std::invoke_result_t<std::decay_t<Function>&>>;
+
+#if WALRUS_ENABLE_COROUTINES
+        // Awaitables for coroutines (see Coroutine.h, which must be included to use them):
+        // co_await Delay(d) resumes the coroutine on the pool after d, co_await Schedule() right away
+        template<typename Rep, typename Period>
+        DelayAwaiter Delay(std::chrono::duration<Rep, Period> delay, TaskPriority priority = TaskPriority::Normal);
+        ScheduleAwaiter Schedule(TaskPriority priority = TaskPriority::Normal);
+#endif
+
+        // PostWithDeadline - hand callback to the thread pool to complete by deadline. Deadline tasks run
+        // before the other tasks of their lane, earliest deadline first; late ones count as misses.
+        // Returns false if the task limit refused the callback.
+        bool PostWithDeadline(EventCallback callback, std::chrono::steady_clock::time_point deadline,
+                              TaskPriority priority = TaskPriority::Normal);
+
+        template<typename Rep, typename Period>
+        bool PostWithDeadline(EventCallback callback, std::chrono::duration<Rep, Period> budget,
+                              TaskPriority priority = TaskPriority::Normal) {
+            return PostWithDeadline(std::move(callback), std::chrono::steady_clock::now() + ToNanoseconds(budget), priority);
+        }
+        void SetTimeoutBatch(std::vector<TimerRequest>& timers, std::vector<EventId>* ids = nullptr);
         
-        // ClearInterval/ClearTimeout - cancel a timer by ID
+        // ClearInterval/ClearTimeout - cancel a timer or immediate by ID
+        // O(1); IDs of events that already ran or were cancelled are ignored, even if their record was reused
         void ClearInterval(EventId id);
         void ClearTimeout(EventId id) { ClearInterval(id); } // Same implementation
         
         // Check if event loop is running
         bool IsRunning() const { return m_Running.load(); }
 
+        TimerBackend GetTimerBackend() const { return m_TimerBackend; }
+
+        // Name of the mechanism the loop thread blocks in ("epoll" or "condition_variable")
+        const char* GetPollerName() const { return m_Poller->GetName(); }
+
+        // Most worker threads the pool runs at once
+        size_t GetWorkerCount() const { return m_ThreadPool.GetMaxThreadCount(); }
+
+        // True when called from one of this loop's pool workers
+        bool IsWorkerThread() const { return m_ThreadPool.GetCurrentWorkerIndex() >= 0; }
+
+        // From a pool worker: run one queued pool task, if there is one. For tasks that wait on
+        // other tasks (see TaskGroup); returns false on any other thread.
+        bool RunPendingTask() { return m_ThreadPool.RunPendingTask(); }
+
+        EventLoopStats GetStats() const;
+
     private:
+#if WALRUS_ENABLE_COROUTINES
+        friend struct DelayAwaiter; // Resumes coroutines through timers exempt from the timer limit
+#endif
+
+        enum class Admission : uint8_t { Queue, Refuse, RunInCaller };
+
+        // A task submitted under OverflowPolicy::DropOldest. Whoever moves state off Queued owns it:
+        // the pool task that runs it, or the submitter that drops it to make room.
+        struct DroppableTask {
+            enum State : uint8_t { Queued, Started, Dropped };
+
+            EventCallback callback;
+            std::atomic<uint8_t> state{Queued};
+        };
+
+        // Outcomes of OverflowStats, written by submitters
+        struct OverflowCounters {
+            std::atomic<uint64_t> blocked{0};
+            std::atomic<uint64_t> rejected{0};
+            std::atomic<uint64_t> ranInCaller{0};
+            std::atomic<uint64_t> droppedOldest{0};
+
+            OverflowStats Load() const;
+        };
+
+        struct ImmediateTask {
+            EventCallback callback;
+            TaskPriority priority = TaskPriority::Normal;
+        };
+
+        // Callbacks ready for the thread pool, one vector per lane
+        using LaneTasks = std::vector<EventCallback>[TaskPriorityCount];
+        using LaneDeadlineTasks = std::vector<DeadlineTask>[TaskPriorityCount];
+
+        template<typename Rep, typename Period>
+        static std::chrono::nanoseconds ToNanoseconds(std::chrono::duration<Rep, Period> duration) {
+            // Round up so a timer never fires before the requested delay
+            return std::chrono::ceil<std::chrono::nanoseconds>(duration);
+        }
+
+        EventId AddTimer(EventCallback callback, IntervalCallback tickCallback, std::chrono::nanoseconds delay, bool repeat,
+                         const TimerSpecification& specification, bool limited = true);
+        size_t TaskBacklog() const;
+        bool InLoopOrWorkerThread() const;
+        Admission AdmitTask();
+        bool AdmitTimer();   // Takes a slot under the timer limit, which must be set
+        void ReleaseTimer(); // Gives a slot back and wakes a blocked caller
+        EventCallback Track(EventCallback callback);
+        bool DropOldestTask();
+        static void RunInCaller(EventCallback& callback);
+        static TimerEvent MakeTimer(EventCallback callback, IntervalCallback tickCallback, std::chrono::nanoseconds delay,
+                                    bool repeat, const TimerSpecification& specification,
+                                    std::chrono::steady_clock::time_point now);
+        bool FireTimer(TimerEvent& event, std::chrono::steady_clock::time_point now);
+        void FireNonOverlapping(const TimerEvent& event, std::chrono::steady_clock::time_point due, uint64_t missedTicks);
+        static void RunNonOverlapping(const std::shared_ptr<IntervalState>& state);
+        void QueueFired(const TimerEvent& event, std::chrono::steady_clock::time_point due, EventCallback task);
+        void DispatchTasks(LaneTasks& tasks, LaneDeadlineTasks* deadlineTasks = nullptr);
+        void Wakeup(std::chrono::steady_clock::time_point deadline);
+        void SignalImmediates();
+        std::chrono::steady_clock::time_point NextWakeupTime();
         void EventLoopThread();
         void ProcessTimerEvents();
         void ProcessImmediateEvents();
-        EventId GenerateId();
 
     private:
         std::atomic<bool> m_Running{false};
         std::thread m_EventThread;
         
         // Timer events management
-        std::mutex m_TimerMutex;
-        std::priority_queue<std::shared_ptr<TimerEvent>, 
-                           std::vector<std::shared_ptr<TimerEvent>>,
-                           std::function<bool(const std::shared_ptr<TimerEvent>&, const std::shared_ptr<TimerEvent>&)>> m_TimerQueue;
-        std::unordered_map<EventId, std::shared_ptr<TimerEvent>> m_TimerMap;
+        TimerBackend m_TimerBackend;
+        mutable std::mutex m_TimerMutex;
+        std::unique_ptr<TimerQueue> m_TimerQueue;
+        size_t m_LiveTimers = 0;                        // Guarded by m_TimerMutex
+        size_t m_TimerRoomWaiters = 0;                  // Guarded by m_TimerMutex, blocked by TimerLimit
+        std::condition_variable m_TimerRoom;            // Signalled when a live timer completes or is cancelled
+        LaneTasks m_FiredTimers;                        // Loop thread only, reused between wakeups
+        LaneDeadlineTasks m_FiredDeadlineTimers;        // Same, for timers with a deadline
+        bool m_TimerDeadlines = false;
         
         // Immediate events management
-        std::mutex m_ImmediateMutex;
-        std::queue<std::shared_ptr<ImmediateEvent>> m_ImmediateQueue;
-        std::unordered_map<EventId, std::shared_ptr<ImmediateEvent>> m_ImmediateMap;
+        // Any thread pushes, the loop thread pops. m_ImmediatesSignalled is cleared by the loop thread
+        // before it checks the queue and goes to sleep; the first producer to set it again notifies.
+        MpscQueue<ImmediateTask> m_Immediates;          // Records recycled once dispatched or cancelled
+        std::atomic<bool> m_ImmediatesSignalled{false};
+        LaneTasks m_ReadyImmediates;                    // Loop thread only, reused between wakeups
         
-        // Thread pool for parallel callback execution
-        std::vector<std::thread> m_ThreadPool;
-        std::queue<std::function<void()>> m_TaskQueue;
-        std::mutex m_TaskMutex;
-        std::condition_variable m_TaskCondition;
-        std::atomic<bool> m_StopThreads{false};
-        
-        // ID generation
-        std::atomic<EventId> m_NextId{1};
+        // Work-stealing thread pool for parallel callback execution
+        ThreadPool m_ThreadPool;
+
+        // Backpressure
+        QueueLimit m_TaskLimit;
+        QueueLimit m_TimerLimit;
+        OverflowCounters m_TaskOverflow;
+        OverflowCounters m_TimerOverflow;
+        std::mutex m_DroppableMutex;
+        std::deque<std::shared_ptr<DroppableTask>> m_Droppable; // Oldest first, guarded by m_DroppableMutex
+        std::atomic<size_t> m_DroppedQueued{0};                 // Dropped tasks whose pool entry has not run yet
         
-        // Condition variable for event loop timing
-        std::condition_variable m_EventCondition;
+        // Event loop timing
+        // m_NextWakeup is when the sleeping loop thread will wake on its own (min() while it is awake
+        // or already notified), producers only notify the poller when they need it earlier.
+        std::unique_ptr<EventPoller> m_Poller;
         std::mutex m_EventMutex;
+        std::chrono::steady_clock::time_point m_NextWakeup = std::chrono::steady_clock::time_point::min(); // Guarded by m_EventMutex
+
+        // Statistics (written by the loop thread only)
+        std::atomic<uint64_t> m_WakeupCount{0};
+        std::atomic<uint64_t> m_TimerWakeupCount{0};
+        std::atomic<uint64_t> m_TimersFired{0};
+        std::atomic<uint64_t> m_MissedIntervalTicks{0};
+        std::atomic<uint64_t> m_SkippedIntervalFires{0};
     };
 
 } // namespace Walrus
@@ -111,12 +379,13 @@ namespace Walrus {
 #else // WALRUS_ENABLE_EVENT_LOOP == 0
 
 // Stub declarations when EventLoop is disabled
-#include <functional>
+#include "UniqueFunction.h"
+
 #include <cstdint>
 
 namespace Walrus {
     
-    using EventCallback = std::function<void()>;
+    using EventCallback = UniqueFunction<void()>;
     using EventId = uint64_t;
     
     class EventLoop {
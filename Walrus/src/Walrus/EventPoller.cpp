@@ -0,0 +1,49 @@
+#include "EventPoller.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#if WALRUS_EVENT_LOOP_EPOLL && defined(WL_PLATFORM_LINUX)
+#include "EpollPoller.h"
+#endif
+
+#include <iostream>
+
+namespace Walrus {
+
+    bool ConditionPoller::Wait(TimePoint deadline) {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+
+        bool notified;
+        if (deadline == TimePoint::max()) {
+            m_Condition.wait(lock, [this] { return m_Notified; });
+            notified = true;
+        } else {
+            notified = m_Condition.wait_until(lock, deadline, [this] { return m_Notified; });
+        }
+
+        m_Notified = false;
+        return notified;
+    }
+
+    void ConditionPoller::Notify() {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Notified = true;
+        }
+        m_Condition.notify_one();
+    }
+
+    std::unique_ptr<EventPoller> CreateEventPoller() {
+#if WALRUS_EVENT_LOOP_EPOLL && defined(WL_PLATFORM_LINUX)
+        auto poller = std::make_unique<EpollPoller>();
+        if (poller->IsValid()) {
+            return poller;
+        }
+        std::cerr << "EventLoop: epoll backend unavailable, falling back to condition_variable" << std::endl;
+#endif
+        return std::make_unique<ConditionPoller>();
+    }
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
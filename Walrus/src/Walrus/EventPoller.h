@@ -0,0 +1,53 @@
+#ifndef WALRUS_EVENTPOLLER_H
+#define WALRUS_EVENTPOLLER_H
+
+#include "Config.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace Walrus {
+
+    // Blocking primitive used by the EventLoop thread to sleep until a deadline or until another
+    // thread calls Notify(). A Notify() issued before Wait() is not lost: the next Wait() returns at once.
+    class EventPoller {
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        virtual ~EventPoller() = default;
+
+        // Block until deadline (TimePoint::max() waits forever) or a notification.
+        // Returns true when woken by Notify(), false when the deadline passed.
+        virtual bool Wait(TimePoint deadline) = 0;
+
+        // Wake the waiting thread, callable from any thread
+        virtual void Notify() = 0;
+
+        virtual const char* GetName() const = 0;
+    };
+
+    // Portable poller built on a condition variable
+    class ConditionPoller : public EventPoller {
+    public:
+        bool Wait(TimePoint deadline) override;
+        void Notify() override;
+        const char* GetName() const override { return "condition_variable"; }
+
+    private:
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        bool m_Notified = false;
+    };
+
+    // Poller selected by WALRUS_EVENT_LOOP_EPOLL, falls back to ConditionPoller when unavailable
+    std::unique_ptr<EventPoller> CreateEventPoller();
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
+
+#endif // WALRUS_EVENTPOLLER_H
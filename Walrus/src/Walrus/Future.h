@@ -0,0 +1,472 @@
+#ifndef WALRUS_FUTURE_H
+#define WALRUS_FUTURE_H
+
+#include "Config.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include "EventLoop.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Walrus {
+
+    // Result of WhenAny: which future completed first, and its value
+    template<typename T>
+    struct WhenAnyResult {
+        size_t Index = 0;
+        T Value;
+    };
+
+    template<>
+    struct WhenAnyResult<void> {
+        size_t Index = 0;
+    };
+
+    namespace Detail {
+
+        // Stand-in value of Future<void>
+        struct Unit {};
+
+        template<typename T>
+        using FutureValue = std::conditional_t<std::is_void_v<T>, Unit, T>;
+
+        // Shared by a Promise and its Future. Completed once, with a value or an exception;
+        // the one continuation registered through OnReady runs on the completing thread.
+        template<typename T>
+        class FutureState {
+        public:
+            explicit FutureState(EventLoop* eventLoop) : loop(eventLoop) {}
+
+            EventLoop* const loop; // Where continuations are scheduled, nullptr = on the completing thread
+
+            bool SetValue(FutureValue<T> value) {
+                return Complete([&]() { m_Value.emplace(std::move(value)); });
+            }
+
+            bool SetException(std::exception_ptr exception) {
+                return Complete([&]() { m_Exception = std::move(exception); });
+            }
+
+            // Run callback once the state is complete: right away if it already is, otherwise on the
+            // thread that completes it. Only one callback can be registered.
+            void OnReady(UniqueFunction<void()> callback) {
+                {
+                    std::lock_guard<std::mutex> lock(m_Mutex);
+                    if (!m_Done) {
+                        m_Callback = std::move(callback);
+                        return;
+                    }
+                }
+                callback();
+            }
+
+            bool IsReady() const {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                return m_Done;
+            }
+
+            void Wait() const {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_ReadyCondition.wait(lock, [this] { return m_Done; });
+            }
+
+            // Complete states only
+            std::exception_ptr Exception() const { return m_Exception; }
+
+            // Complete states only. Moves the value out, or rethrows the exception.
+            FutureValue<T> TakeValue() {
+                if (m_Exception) {
+                    std::rethrow_exception(m_Exception);
+                }
+                return std::move(*m_Value);
+            }
+
+        private:
+            template<typename Function>
+            bool Complete(Function&& store) {
+                UniqueFunction<void()> callback;
+                {
+                    std::lock_guard<std::mutex> lock(m_Mutex);
+                    if (m_Done) {
+                        return false;
+                    }
+                    store();
+                    m_Done = true;
+                    callback = std::move(m_Callback);
+                }
+                m_ReadyCondition.notify_all();
+
+                if (callback) {
+                    callback();
+                }
+                return true;
+            }
+
+        private:
+            mutable std::mutex m_Mutex;
+            mutable std::condition_variable m_ReadyCondition;
+            bool m_Done = false;
+            std::optional<FutureValue<T>> m_Value;
+            std::exception_ptr m_Exception;
+            UniqueFunction<void()> m_Callback;
+        };
+
+        struct FutureAccess;
+
+    } // namespace Detail
+
+    // Result of a task that completes later. Future is move-only and has a single consumer:
+    // either Then() a continuation, which runs on the EventLoop pool once the value is ready and
+    // never blocks a thread while it waits, or Get() the value. Exceptions thrown by the task
+    // travel along and are rethrown by Get().
+    template<typename T>
+    class Future {
+    public:
+        using ValueType = T;
+
+        Future() = default;
+
+        bool Valid() const { return m_State != nullptr; }
+        bool IsReady() const { return m_State->IsReady(); }
+
+        // Block until the value is ready. Do not call this from a pool task: use Then() there,
+        // a worker blocked on work queued behind it can stall the pool.
+        void Wait() const { m_State->Wait(); }
+
+        // Wait, then return the value or rethrow the exception. Consumes the future.
+        T Get() {
+            auto state = std::move(m_State);
+            state->Wait();
+            if constexpr (std::is_void_v<T>) {
+                state->TakeValue();
+            } else {
+                return state->TakeValue();
+            }
+        }
+
+        // Schedule function on the pool once the value is ready and return a future of its result.
+        // function takes the value (nothing for Future<void>), or the ready Future<T> itself to
+        // handle exceptions; in the first form an exception skips it and is passed on. A function
+        // that returns a Future is unwrapped. Consumes this future.
+        template<typename Function>
+        auto Then(Function&& function, TaskPriority priority = TaskPriority::Normal);
+
+    private:
+        friend struct Detail::FutureAccess;
+
+        explicit Future(std::shared_ptr<Detail::FutureState<T>> state) : m_State(std::move(state)) {}
+
+    private:
+        std::shared_ptr<Detail::FutureState<T>> m_State;
+    };
+
+    // Producer side of a Future. Continuations of the future are scheduled on loop; a promise made
+    // without one runs them on the thread that sets the value. A promise destroyed before it is
+    // set fails its future with std::future_errc::broken_promise.
+    template<typename T>
+    class Promise {
+    public:
+        Promise() : m_State(std::make_shared<Detail::FutureState<T>>(nullptr)) {}
+        explicit Promise(EventLoop& loop) : m_State(std::make_shared<Detail::FutureState<T>>(&loop)) {}
+        ~Promise() { Abandon(); }
+
+        Promise(Promise&&) = default;
+        Promise& operator=(Promise&& other) {
+            if (this != &other) {
+                Abandon();
+                m_State = std::move(other.m_State);
+            }
+            return *this;
+        }
+
+        Promise(const Promise&) = delete;
+        Promise& operator=(const Promise&) = delete;
+
+        // The future of this promise; call once
+        Future<T> GetFuture();
+
+        template<typename U = T, std::enable_if_t<!std::is_void_v<U>, int> = 0>
+        void SetValue(Detail::FutureValue<U> value) { m_State->SetValue(std::move(value)); }
+
+        template<typename U = T, std::enable_if_t<std::is_void_v<U>, int> = 0>
+        void SetValue() { m_State->SetValue(Detail::Unit{}); }
+
+        void SetException(std::exception_ptr exception) { m_State->SetException(std::move(exception)); }
+
+    private:
+        void Abandon() {
+            if (m_State && !m_State->IsReady()) {
+                m_State->SetException(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+            }
+        }
+
+    private:
+        std::shared_ptr<Detail::FutureState<T>> m_State;
+    };
+
+    namespace Detail {
+
+        struct FutureAccess {
+            template<typename T>
+            static Future<T> Make(std::shared_ptr<FutureState<T>> state) { return Future<T>(std::move(state)); }
+
+            template<typename T>
+            static std::shared_ptr<FutureState<T>> Take(Future<T>& future) { return std::move(future.m_State); }
+
+            template<typename T>
+            static EventLoop* Loop(const Future<T>& future) { return future.m_State->loop; }
+        };
+
+        // What a continuation takes and returns: the value when it accepts one, otherwise the ready future
+        template<typename T, typename Function>
+        struct ContinuationTraits {
+            static constexpr bool TakesValue = std::is_invocable_v<Function&, T&&>;
+            using Result = typename std::conditional_t<TakesValue, std::invoke_result<Function&, T&&>,
+                                                       std::invoke_result<Function&, Future<T>>>::type;
+        };
+
+        template<typename Function>
+        struct ContinuationTraits<void, Function> {
+            static constexpr bool TakesValue = std::is_invocable_v<Function&>;
+            using Result = typename std::conditional_t<TakesValue, std::invoke_result<Function&>,
+                                                       std::invoke_result<Function&, Future<void>>>::type;
+        };
+
+        template<typename R>
+        struct UnwrapFuture {
+            using Type = R;
+            static constexpr bool IsFuture = false;
+        };
+
+        template<typename U>
+        struct UnwrapFuture<Future<U>> {
+            using Type = U;
+            static constexpr bool IsFuture = true;
+        };
+
+        // Complete target with whatever source completes with
+        template<typename T>
+        void Forward(std::shared_ptr<FutureState<T>> source, std::shared_ptr<FutureState<T>> target) {
+            FutureState<T>* raw = source.get();
+            raw->OnReady([source = std::move(source), target = std::move(target)]() {
+                if (std::exception_ptr exception = source->Exception()) {
+                    target->SetException(exception);
+                } else {
+                    target->SetValue(source->TakeValue());
+                }
+            });
+        }
+
+        // Run function and complete state with its result or exception
+        template<typename T, typename Function>
+        void Fulfil(FutureState<T>& state, Function& function) {
+            try {
+                if constexpr (std::is_void_v<T>) {
+                    function();
+                    state.SetValue(Unit{});
+                } else {
+                    state.SetValue(function());
+                }
+            } catch (...) {
+                state.SetException(std::current_exception());
+            }
+        }
+
+        template<typename T, typename Function, typename Value>
+        void RunContinuation(std::shared_ptr<FutureState<T>> state, const std::shared_ptr<FutureState<Value>>& next,
+                             Function& function) {
+            using Traits = ContinuationTraits<T, Function>;
+            using Result = typename Traits::Result;
+
+            if constexpr (Traits::TakesValue) {
+                if (std::exception_ptr exception = state->Exception()) {
+                    next->SetException(exception);
+                    return;
+                }
+            }
+
+            auto invoke = [&]() -> Result {
+                if constexpr (!Traits::TakesValue) {
+                    return function(FutureAccess::Make(std::move(state)));
+                } else if constexpr (std::is_void_v<T>) {
+                    return function();
+                } else {
+                    return function(state->TakeValue());
+                }
+            };
+
+            if constexpr (UnwrapFuture<Result>::IsFuture) {
+                try {
+                    Result inner = invoke();
+                    if (!inner.Valid()) {
+                        throw std::future_error(std::future_errc::no_state);
+                    }
+                    Forward(FutureAccess::Take(inner), next);
+                } catch (...) {
+                    next->SetException(std::current_exception());
+                }
+            } else {
+                Fulfil(*next, invoke);
+            }
+        }
+
+    } // namespace Detail
+
+    template<typename T>
+    Future<T> Promise<T>::GetFuture() {
+        return Detail::FutureAccess::Make(m_State);
+    }
+
+    template<typename T>
+    template<typename Function>
+    auto Future<T>::Then(Function&& function, TaskPriority priority) {
+        using Callable = std::decay_t<Function>;
+        using Value = typename Detail::UnwrapFuture<typename Detail::ContinuationTraits<T, Callable>::Result>::Type;
+
+        auto state = std::move(m_State);
+        auto next = std::make_shared<Detail::FutureState<Value>>(state->loop);
+        Detail::FutureState<T>* raw = state.get();
+
+        // Registered on the state itself, which keeps it alive until it completes
+        raw->OnReady([state, next, callable = Callable(std::forward<Function>(function)), priority]() mutable {
+            EventLoop* loop = next->loop;
+            auto task = [state = std::move(state), next = std::move(next), callable = std::move(callable)]() mutable {
+                Detail::RunContinuation(std::move(state), next, callable);
+            };
+
+            if (loop) {
+                loop->PostContinuation(std::move(task), priority);
+            } else {
+                task();
+            }
+        });
+        return Detail::FutureAccess::Make(std::move(next));
+    }
+
+    template<typename Function>
+    auto EventLoop::Submit(Function&& function, TaskPriority priority) -> Future<std::invoke_result_t<std::decay_t<Function>&>> {
+        using Result = std::invoke_result_t<std::decay_t<Function>&>;
+
+        // The task owns the promise: one refused or dropped by the task limit breaks it
+        Promise<Result> promise(*this);
+        Future<Result> future = promise.GetFuture();
+        Post([promise = std::move(promise), function = std::decay_t<Function>(std::forward<Function>(function))]() mutable {
+            try {
+                if constexpr (std::is_void_v<Result>) {
+                    function();
+                    promise.SetValue();
+                } else {
+                    promise.SetValue(function());
+                }
+            } catch (...) {
+                promise.SetException(std::current_exception());
+            }
+        }, priority);
+        return future;
+    }
+
+    // Future that completes once every future in futures has: with their values in the same order
+    // (nothing for void), or with the first exception any of them produced. Consumes the futures.
+    template<typename T>
+    auto WhenAll(std::vector<Future<T>> futures) {
+        using Result = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+
+        struct Gather {
+            std::vector<std::optional<Detail::FutureValue<T>>> values;
+            std::atomic<size_t> remaining;
+            std::atomic<bool> failed{false};
+            std::shared_ptr<Detail::FutureState<Result>> result;
+        };
+
+        const size_t count = futures.size();
+        auto gather = std::make_shared<Gather>();
+        gather->values.resize(count);
+        gather->remaining.store(count);
+        gather->result = std::make_shared<Detail::FutureState<Result>>(
+            count > 0 ? Detail::FutureAccess::Loop(futures[0]) : nullptr);
+
+        Future<Result> all = Detail::FutureAccess::Make(gather->result);
+        if (count == 0) {
+            gather->result->SetValue({});
+            return all;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            auto state = Detail::FutureAccess::Take(futures[i]);
+            Detail::FutureState<T>* raw = state.get();
+            raw->OnReady([gather, state = std::move(state), i]() {
+                if (std::exception_ptr exception = state->Exception()) {
+                    if (!gather->failed.exchange(true)) {
+                        gather->result->SetException(exception);
+                    }
+                } else {
+                    gather->values[i].emplace(state->TakeValue());
+                }
+
+                // The last one to finish publishes the values, the fetch_sub orders their writes before it
+                if (gather->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 && !gather->failed.load()) {
+                    if constexpr (std::is_void_v<T>) {
+                        gather->result->SetValue(Detail::Unit{});
+                    } else {
+                        std::vector<T> values;
+                        values.reserve(gather->values.size());
+                        for (auto& value : gather->values) {
+                            values.push_back(std::move(*value));
+                        }
+                        gather->result->SetValue(std::move(values));
+                    }
+                }
+            });
+        }
+        return all;
+    }
+
+    // Future that completes with the first of futures to complete, value or exception.
+    // Consumes the futures; with none it never completes.
+    template<typename T>
+    Future<WhenAnyResult<T>> WhenAny(std::vector<Future<T>> futures) {
+        struct Race {
+            std::atomic<bool> decided{false};
+            std::shared_ptr<Detail::FutureState<WhenAnyResult<T>>> result;
+        };
+
+        auto race = std::make_shared<Race>();
+        race->result = std::make_shared<Detail::FutureState<WhenAnyResult<T>>>(
+            futures.empty() ? nullptr : Detail::FutureAccess::Loop(futures[0]));
+        Future<WhenAnyResult<T>> any = Detail::FutureAccess::Make(race->result);
+
+        for (size_t i = 0; i < futures.size(); ++i) {
+            auto state = Detail::FutureAccess::Take(futures[i]);
+            Detail::FutureState<T>* raw = state.get();
+            raw->OnReady([race, state = std::move(state), i]() {
+                if (race->decided.exchange(true)) {
+                    return;
+                }
+                if (std::exception_ptr exception = state->Exception()) {
+                    race->result->SetException(exception);
+                } else if constexpr (std::is_void_v<T>) {
+                    race->result->SetValue(WhenAnyResult<T>{ i });
+                } else {
+                    race->result->SetValue(WhenAnyResult<T>{ i, state->TakeValue() });
+                }
+            });
+        }
+        return any;
+    }
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
+
+#endif // WALRUS_FUTURE_H
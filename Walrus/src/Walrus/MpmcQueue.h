@@ -0,0 +1,101 @@
+#ifndef WALRUS_MPMCQUEUE_H
+#define WALRUS_MPMCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace Walrus {
+
+    // Bounded lock-free multi-producer multi-consumer queue (Vyukov's ring). Every cell carries a
+    // sequence number that says whether it is waiting for a producer or a consumer of the current
+    // lap, so a push or pop is one CAS on the shared position and nobody ever waits on a lock.
+    // The capacity is fixed (rounded up to a power of two) and TryPush fails when it is full.
+    template<typename T>
+    class MpmcQueue {
+    public:
+        explicit MpmcQueue(size_t capacity) {
+            size_t size = 2;
+            while (size < capacity) {
+                size <<= 1;
+            }
+
+            m_Cells = std::make_unique<Cell[]>(size);
+            m_Mask = size - 1;
+            for (size_t i = 0; i < size; ++i) {
+                m_Cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpmcQueue(const MpmcQueue&) = delete;
+        MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+        // Moves from value only on success, so a caller can fall back to another queue when full
+        bool TryPush(T&& value) {
+            size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &m_Cells[position & m_Mask];
+                const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+                if (difference == 0) {
+                    if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (difference < 0) {
+                    return false; // Full: the cell still holds last lap's value
+                } else {
+                    position = m_EnqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->value = std::move(value);
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool TryPop(T& value) {
+            size_t position = m_DequeuePosition.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &m_Cells[position & m_Mask];
+                const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+                if (difference == 0) {
+                    if (m_DequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (difference < 0) {
+                    return false; // Empty, or the producer of this cell has not finished writing it
+                } else {
+                    position = m_DequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            value = std::move(cell->value);
+            cell->value = T(); // Release whatever the moved-from value still holds
+            cell->sequence.store(position + m_Mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t Capacity() const { return m_Mask + 1; }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence{0};
+            T value{};
+        };
+
+        std::unique_ptr<Cell[]> m_Cells;
+        size_t m_Mask = 0;
+        alignas(64) std::atomic<size_t> m_EnqueuePosition{0};
+        alignas(64) std::atomic<size_t> m_DequeuePosition{0};
+    };
+
+} // namespace Walrus
+
+#endif // WALRUS_MPMCQUEUE_H
@@ -0,0 +1,320 @@
+#ifndef WALRUS_MPSCQUEUE_H
+#define WALRUS_MPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Walrus {
+
+    // Lock-free multi-producer single-consumer queue of pooled records.
+    // Any thread may Push and Cancel, only one thread (the consumer) may Pop. Records are linked
+    // into the queue intrusively (Vyukov's MPSC queue: one exchange on the tail per push) and
+    // recycled through a lock-free free list, so producers never block each other or the consumer
+    // and a warm queue does not allocate. Records live in chunks that are never freed; adding a
+    // chunk takes a mutex, which only happens when every record is in use.
+    // Like Slab, every record carries a generation that changes when it is recycled, so the
+    // (index, generation) pair returned by Push identifies that one push and cancels it in O(1).
+    template<typename T>
+    class MpscQueue {
+    public:
+        static constexpr uint32_t InvalidIndex = UINT32_MAX;
+        static constexpr uint32_t MaxGeneration = 0x7FFFFFFF; // Generations are 1..MaxGeneration (31 bits)
+
+        explicit MpscQueue(size_t capacity = 0) {
+            while (m_Capacity.load(std::memory_order_relaxed) < capacity) {
+                std::lock_guard<std::mutex> lock(m_GrowMutex);
+                Grow(false);
+            }
+        }
+
+        ~MpscQueue() {
+            for (auto& chunk : m_Chunks) {
+                delete[] chunk.load(std::memory_order_relaxed);
+            }
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        // Any thread. Returns the record index and its generation for Cancel.
+        uint32_t Push(T value, uint32_t& generation) {
+            const uint32_t index = Acquire();
+            Record& record = At(index);
+            record.value = std::move(value);
+            record.next.store(InvalidIndex, std::memory_order_relaxed);
+            generation = record.stamp.load(std::memory_order_relaxed) >> 1;
+
+            // Sequentially consistent, see Size()
+            m_Live.fetch_add(1);
+            Link(index, index);
+            return index;
+        }
+
+        // Any thread. Pushes values[0..count) in order, taking their records from the free list with one
+        // CAS (while it holds enough) and linking them with one exchange on the tail, so the consumer
+        // sees all or none of them. The values are moved from; onPush(i, index, generation) receives
+        // the handle of values[i].
+        template<typename Function>
+        void PushBulk(T* values, size_t count, Function&& onPush) {
+            PushBulk(count, [values](size_t i) -> T&& { return std::move(values[i]); }, std::forward<Function>(onPush));
+        }
+
+        // Same, with the values produced in order by produce(i) instead of read from an array
+        template<typename Producer, typename Function>
+        void PushBulk(size_t count, Producer&& produce, Function&& onPush) {
+            if (count == 0) {
+                return;
+            }
+
+            uint32_t first = InvalidIndex;
+            uint32_t last = InvalidIndex;
+            size_t pushed = 0;
+            while (pushed < count) {
+                size_t length;
+                uint32_t index = AcquireChain(count - pushed, length);
+
+                for (size_t i = 0; i < length; ++i, ++pushed) {
+                    Record& record = At(index);
+                    const uint32_t nextFree = record.nextFree.load(std::memory_order_relaxed);
+
+                    record.value = produce(pushed);
+                    record.next.store(InvalidIndex, std::memory_order_relaxed);
+                    onPush(pushed, index, record.stamp.load(std::memory_order_relaxed) >> 1);
+
+                    // Chain privately, the exchange in Link publishes the whole run
+                    if (last != InvalidIndex) {
+                        At(last).next.store(index, std::memory_order_relaxed);
+                    } else {
+                        first = index;
+                    }
+                    last = index;
+                    index = nextFree;
+                }
+            }
+
+            m_Live.fetch_add(count);
+            Link(first, last);
+        }
+
+        // Any thread. True if the push was still queued; the consumer then drops it instead of
+        // returning it. The value is destroyed on the consumer thread when it reaches the front.
+        bool Cancel(uint32_t index, uint32_t generation) {
+            if (index >= m_Capacity.load(std::memory_order_acquire)) {
+                return false;
+            }
+            uint32_t expected = generation << 1;
+            return At(index).stamp.compare_exchange_strong(expected, expected | 1, std::memory_order_acq_rel);
+        }
+
+        // Consumer only. Moves the oldest value that was not cancelled into value. Returns false
+        // when the queue is empty or the next push is still being linked by its producer.
+        bool Pop(T& value) {
+            while (true) {
+                const uint32_t index = PopIndex();
+                if (index == InvalidIndex) {
+                    return false;
+                }
+
+                Record& record = At(index);
+
+                // Retire this use of the record: a concurrent Cancel either lands first or fails
+                const uint32_t generation = record.stamp.load(std::memory_order_relaxed) >> 1;
+                const uint32_t next = generation == MaxGeneration ? 1 : generation + 1;
+                const bool cancelled = (record.stamp.exchange(next << 1, std::memory_order_acq_rel) & 1) != 0;
+
+                if (!cancelled) {
+                    value = std::move(record.value);
+                }
+                record.value = T(); // Release whatever the record still holds
+                Release(index);
+
+                if (!cancelled) {
+                    return true;
+                }
+            }
+        }
+
+        // Pushed but not yet popped, cancelled pushes included. Producers increment the count before
+        // linking and both sides use sequentially consistent operations, so a consumer that reads 0
+        // here after clearing a flag is guaranteed to be signalled by the next producer.
+        size_t Size() const { return m_Live.load(); }
+        size_t Capacity() const { return m_Capacity.load(std::memory_order_relaxed); }
+        size_t HighWater() const { return m_HighWater.load(std::memory_order_relaxed); } // Sampled by the consumer
+
+    private:
+        struct Record {
+            T value{};
+            std::atomic<uint32_t> next{InvalidIndex};     // Queue link
+            std::atomic<uint32_t> nextFree{InvalidIndex}; // Free list link
+            std::atomic<uint32_t> stamp{1 << 1};          // generation << 1 | cancelled
+        };
+
+        // Chunk 0 and 1 hold FirstChunkSize records, every further chunk doubles the total
+        static constexpr uint32_t FirstChunkShift = 6;
+        static constexpr uint32_t FirstChunkSize = 1u << FirstChunkShift;
+        static constexpr size_t MaxChunks = 32 - FirstChunkShift + 1;
+        static constexpr uint32_t StubIndex = InvalidIndex - 1;
+
+        static uint32_t HighestBit(uint32_t value) {
+#if defined(_MSC_VER)
+            unsigned long bit;
+            _BitScanReverse(&bit, value);
+            return static_cast<uint32_t>(bit);
+#else
+            return 31 - static_cast<uint32_t>(__builtin_clz(value));
+#endif
+        }
+
+        Record& At(uint32_t index) {
+            if (index == StubIndex) {
+                return m_Stub;
+            }
+            if (index < FirstChunkSize) {
+                return m_Chunks[0].load(std::memory_order_acquire)[index];
+            }
+            const uint32_t bit = HighestBit(index);
+            return m_Chunks[bit - FirstChunkShift + 1].load(std::memory_order_acquire)[index - (1u << bit)];
+        }
+
+        void Link(uint32_t first, uint32_t last) {
+            const uint32_t previous = m_Tail.exchange(last, std::memory_order_acq_rel);
+            At(previous).next.store(first, std::memory_order_release);
+        }
+
+        uint32_t PopIndex() {
+            uint32_t head = m_Head;
+            uint32_t next = At(head).next.load(std::memory_order_acquire);
+
+            if (head == StubIndex) {
+                if (next == InvalidIndex) {
+                    return InvalidIndex;
+                }
+                m_Head = head = next;
+                next = At(head).next.load(std::memory_order_acquire);
+            }
+
+            if (next != InvalidIndex) {
+                m_Head = next;
+                SampleHighWater();
+                return head;
+            }
+
+            if (head != m_Tail.load(std::memory_order_acquire)) {
+                return InvalidIndex; // A producer has swapped the tail but not linked its record yet
+            }
+
+            // head is the last record: put the stub behind it so head can be handed out
+            m_Stub.next.store(InvalidIndex, std::memory_order_relaxed);
+            Link(StubIndex, StubIndex);
+
+            next = At(head).next.load(std::memory_order_acquire);
+            if (next != InvalidIndex) {
+                m_Head = next;
+                SampleHighWater();
+                return head;
+            }
+            return InvalidIndex;
+        }
+
+        void SampleHighWater() {
+            const size_t live = m_Live.load(std::memory_order_relaxed);
+            if (live > m_HighWater.load(std::memory_order_relaxed)) {
+                m_HighWater.store(live, std::memory_order_relaxed);
+            }
+        }
+
+        uint32_t Acquire() {
+            size_t length;
+            return AcquireChain(1, length);
+        }
+
+        // Any thread. Pops up to wanted records off the free list at once and returns the first;
+        // they stay linked through nextFree. The tag in the upper half of m_FreeHead changes on
+        // every update, so if the CAS succeeds nothing touched the list while we walked it (ABA).
+        uint32_t AcquireChain(size_t wanted, size_t& length) {
+            uint64_t head = m_FreeHead.load(std::memory_order_acquire);
+            while (true) {
+                const uint32_t index = static_cast<uint32_t>(head);
+                if (index == InvalidIndex) {
+                    std::lock_guard<std::mutex> lock(m_GrowMutex);
+                    head = m_FreeHead.load(std::memory_order_acquire);
+                    if (static_cast<uint32_t>(head) == InvalidIndex) {
+                        length = 1;
+                        return Grow(true); // Still empty, nobody grew the pool while we waited
+                    }
+                    continue;
+                }
+
+                length = 1;
+                uint32_t next = At(index).nextFree.load(std::memory_order_relaxed);
+                while (length < wanted && next != InvalidIndex) {
+                    next = At(next).nextFree.load(std::memory_order_relaxed);
+                    length++;
+                }
+
+                const uint64_t desired = (((head >> 32) + 1) << 32) | next;
+                if (m_FreeHead.compare_exchange_weak(head, desired, std::memory_order_acquire, std::memory_order_acquire)) {
+                    return index;
+                }
+            }
+        }
+
+        // Consumer only (the free list also takes whole chunks from Grow)
+        void Release(uint32_t index) {
+            m_Live.fetch_sub(1);
+            Free(index, index);
+        }
+
+        // Splice the chain first..last (linked through nextFree) onto the free list
+        void Free(uint32_t first, uint32_t last) {
+            uint64_t head = m_FreeHead.load(std::memory_order_relaxed);
+            uint64_t desired;
+            do {
+                At(last).nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+                desired = (((head >> 32) + 1) << 32) | first;
+            } while (!m_FreeHead.compare_exchange_weak(head, desired, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // Called with m_GrowMutex held. Adds a chunk and frees its records, except the first one
+        // when keepFirst is set, which is returned to the caller instead.
+        uint32_t Grow(bool keepFirst) {
+            const size_t chunk = m_ChunkCount++;
+            const uint32_t size = chunk == 0 ? FirstChunkSize : FirstChunkSize << (chunk - 1);
+            const uint32_t base = chunk == 0 ? 0 : size;
+
+            Record* records = new Record[size];
+            for (uint32_t i = 0; i + 1 < size; ++i) {
+                records[i].nextFree.store(base + i + 1, std::memory_order_relaxed);
+            }
+            m_Chunks[chunk].store(records, std::memory_order_release);
+            m_Capacity.store(base + size, std::memory_order_release);
+
+            const uint32_t first = keepFirst ? base + 1 : base;
+            Free(first, base + size - 1);
+            return keepFirst ? base : InvalidIndex;
+        }
+
+    private:
+        alignas(64) std::atomic<uint32_t> m_Tail{StubIndex};    // Producers
+        alignas(64) std::atomic<uint64_t> m_FreeHead{InvalidIndex}; // tag << 32 | index
+        alignas(64) std::atomic<size_t> m_Live{0};
+        alignas(64) uint32_t m_Head = StubIndex;                // Consumer only
+        std::atomic<size_t> m_HighWater{0};
+        Record m_Stub;
+
+        std::atomic<Record*> m_Chunks[MaxChunks] = {};
+        std::atomic<size_t> m_Capacity{0};
+        size_t m_ChunkCount = 0;                                // Guarded by m_GrowMutex
+        std::mutex m_GrowMutex;
+    };
+
+} // namespace Walrus
+
+#endif // WALRUS_MPSCQUEUE_H
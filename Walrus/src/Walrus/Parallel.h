@@ -0,0 +1,270 @@
+#ifndef WALRUS_PARALLEL_H
+#define WALRUS_PARALLEL_H
+
+#include "Config.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include "EventLoop.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Data-parallel algorithms on an EventLoop's thread pool. The range is cut into chunks of grain
+// elements (0 = about ChunksPerThread chunks per thread) that the calling thread and up to one
+// helper task per worker claim from a shared counter, so the caller always makes progress itself:
+// the algorithms also work from inside pool tasks and before the loop has started. Every call
+// blocks until the whole range is done. An exception thrown by the body stops the remaining chunks
+// from starting and is rethrown to the caller once the running ones have finished.
+
+namespace Walrus {
+
+    namespace Detail {
+
+        constexpr size_t ChunksPerThread = 4;
+        constexpr size_t WaitSpins = 64; // Yields before the caller sleeps on the chunks still running
+
+        // Run function(chunk) for every chunk in [0, chunkCount) on loop's pool and the calling thread
+        template<typename Function>
+        void RunChunks(EventLoop& loop, size_t chunkCount, Function& function) {
+            if (chunkCount == 0) {
+                return;
+            }
+            if (chunkCount == 1) {
+                function(0);
+                return;
+            }
+
+            // Shared with the helper tasks, which may only start after the call has returned; those
+            // find no chunk left to claim and never touch function
+            struct Chunks {
+                Function* function = nullptr;
+                size_t count = 0;
+                std::atomic<size_t> next{0};
+                std::atomic<size_t> finished{0};
+                std::atomic<bool> failed{false};
+                std::mutex mutex;
+                std::condition_variable done;  // Signalled under mutex when the last chunk finishes
+                std::exception_ptr exception; // Guarded by mutex
+
+                void Drain() {
+                    for (;;) {
+                        const size_t chunk = next.fetch_add(1, std::memory_order_relaxed);
+                        if (chunk >= count) {
+                            return;
+                        }
+                        if (!failed.load(std::memory_order_relaxed)) {
+                            try {
+                                (*function)(chunk);
+                            } catch (...) {
+                                std::lock_guard<std::mutex> lock(mutex);
+                                if (!exception) {
+                                    exception = std::current_exception();
+                                }
+                                failed.store(true, std::memory_order_relaxed);
+                            }
+                        }
+                        if (finished.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            done.notify_all();
+                        }
+                    }
+                }
+            };
+
+            auto chunks = std::make_shared<Chunks>();
+            chunks->function = &function;
+            chunks->count = chunkCount;
+
+            const size_t helpers = std::min(chunkCount - 1, loop.GetWorkerCount());
+            std::vector<EventCallback> tasks;
+            tasks.reserve(helpers);
+            for (size_t i = 0; i < helpers; ++i) {
+                tasks.push_back([chunks]() { chunks->Drain(); });
+            }
+            // The helpers serve a call that is already running, so the task limit must not refuse,
+            // drop or count them
+            loop.PostContinuation(tasks);
+
+            // Every chunk is claimed once Drain returns, only the ones still running elsewhere are
+            // left: yield for a short while, then sleep until the last of them finishes
+            chunks->Drain();
+            for (size_t spin = 0; spin < WaitSpins; ++spin) {
+                if (chunks->finished.load(std::memory_order_acquire) >= chunkCount) {
+                    break;
+                }
+                std::this_thread::yield();
+            }
+
+            std::unique_lock<std::mutex> lock(chunks->mutex);
+            chunks->done.wait(lock, [&chunks, chunkCount]() {
+                return chunks->finished.load(std::memory_order_acquire) >= chunkCount;
+            });
+            if (chunks->exception) {
+                std::rethrow_exception(chunks->exception);
+            }
+        }
+
+        // Elements per chunk for count elements
+        inline size_t ChunkSize(EventLoop& loop, size_t count, size_t grain) {
+            if (grain > 0) {
+                return grain;
+            }
+            const size_t chunks = (loop.GetWorkerCount() + 1) * ChunksPerThread;
+            return std::max<size_t>(1, (count + chunks - 1) / chunks);
+        }
+
+    } // namespace Detail
+
+    // Call body(chunkBegin, chunkEnd) for consecutive chunks covering [begin, end)
+    template<typename Function>
+    void ParallelForRange(EventLoop& loop, size_t begin, size_t end, Function&& body, size_t grain = 0) {
+        if (end <= begin) {
+            return;
+        }
+
+        const size_t count = end - begin;
+        const size_t chunkSize = Detail::ChunkSize(loop, count, grain);
+        auto chunk = [&](size_t index) {
+            const size_t chunkBegin = begin + index * chunkSize;
+            body(chunkBegin, std::min(end, chunkBegin + chunkSize));
+        };
+        Detail::RunChunks(loop, (count + chunkSize - 1) / chunkSize, chunk);
+    }
+
+    // Call body(i) for every i in [begin, end)
+    template<typename Function>
+    void ParallelFor(EventLoop& loop, size_t begin, size_t end, Function&& body, size_t grain = 0) {
+        ParallelForRange(loop, begin, end, [&](size_t chunkBegin, size_t chunkEnd) {
+            for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+                body(i);
+            }
+        }, grain);
+    }
+
+    // reduce(init, transform(x)...) over [first, last). reduce must be associative; the chunk results
+    // are combined in order, so it need not be commutative.
+    template<typename RandomIt, typename T, typename Reduce, typename Transform>
+    T ParallelTransformReduce(EventLoop& loop, RandomIt first, RandomIt last, T init, Reduce reduce, Transform transform,
+                              size_t grain = 0) {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count == 0) {
+            return init;
+        }
+
+        const size_t chunkSize = Detail::ChunkSize(loop, count, grain);
+        std::vector<std::optional<T>> partials((count + chunkSize - 1) / chunkSize);
+        auto chunk = [&](size_t index) {
+            RandomIt it = first + index * chunkSize;
+            RandomIt chunkEnd = first + std::min(count, (index + 1) * chunkSize);
+            T value = transform(*it);
+            for (++it; it != chunkEnd; ++it) {
+                value = reduce(std::move(value), transform(*it));
+            }
+            partials[index].emplace(std::move(value));
+        };
+        Detail::RunChunks(loop, partials.size(), chunk);
+
+        for (auto& partial : partials) {
+            init = reduce(std::move(init), std::move(*partial));
+        }
+        return init;
+    }
+
+    // op(init, x...) over [first, last), op associative
+    template<typename RandomIt, typename T, typename BinaryOp = std::plus<>>
+    T ParallelReduce(EventLoop& loop, RandomIt first, RandomIt last, T init, BinaryOp op = BinaryOp(), size_t grain = 0) {
+        return ParallelTransformReduce(loop, first, last, std::move(init), op,
+                                       [](const auto& value) -> const auto& { return value; }, grain);
+    }
+
+    // out[i] = op(in[0], ..., in[i]) with op associative; out may be first. Two passes: chunk totals,
+    // then every chunk scans again from the total of the chunks before it. Returns the end of out.
+    template<typename RandomIt, typename OutputIt, typename BinaryOp = std::plus<>>
+    OutputIt ParallelInclusiveScan(EventLoop& loop, RandomIt first, RandomIt last, OutputIt out,
+                                   BinaryOp op = BinaryOp(), size_t grain = 0) {
+        using Value = typename std::iterator_traits<RandomIt>::value_type;
+
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count == 0) {
+            return out;
+        }
+
+        const size_t chunkSize = Detail::ChunkSize(loop, count, grain);
+        const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+        auto chunkEnd = [&](size_t index) { return std::min(count, (index + 1) * chunkSize); };
+
+        // Totals of every chunk but the last, which nothing depends on
+        std::vector<std::optional<Value>> totals(chunkCount - 1);
+        auto total = [&](size_t index) {
+            RandomIt it = first + index * chunkSize;
+            RandomIt end = first + chunkEnd(index);
+            Value value = *it;
+            for (++it; it != end; ++it) {
+                value = op(std::move(value), *it);
+            }
+            totals[index].emplace(std::move(value));
+        };
+        Detail::RunChunks(loop, totals.size(), total);
+
+        // totals[i] becomes the total of chunks [0, i]
+        for (size_t i = 1; i < totals.size(); ++i) {
+            totals[i].emplace(op(std::move(*totals[i - 1]), std::move(*totals[i])));
+        }
+
+        auto scan = [&](size_t index) {
+            const size_t begin = index * chunkSize;
+            const size_t end = chunkEnd(index);
+            Value value = index == 0 ? Value(first[begin]) : op(*totals[index - 1], first[begin]);
+            out[begin] = value;
+            for (size_t i = begin + 1; i < end; ++i) {
+                value = op(std::move(value), first[i]);
+                out[i] = value;
+            }
+        };
+        Detail::RunChunks(loop, chunkCount, scan);
+        return out + count;
+    }
+
+    // Sort [first, last) by comp: the chunks are sorted in parallel, then merged pairwise in
+    // parallel rounds. Not stable.
+    template<typename RandomIt, typename Compare = std::less<>>
+    void ParallelSort(EventLoop& loop, RandomIt first, RandomIt last, Compare comp = Compare(), size_t grain = 0) {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count < 2) {
+            return;
+        }
+
+        // One chunk per thread unless asked otherwise: each doubling of the chunks adds a merge round
+        const size_t threads = loop.GetWorkerCount() + 1;
+        const size_t chunkSize = grain > 0 ? grain : std::max<size_t>(1, (count + threads - 1) / threads);
+        const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+        auto offset = [&](size_t chunk) { return first + std::min(count, chunk * chunkSize); };
+
+        auto sort = [&](size_t index) { std::sort(offset(index), offset(index + 1), comp); };
+        Detail::RunChunks(loop, chunkCount, sort);
+
+        for (size_t width = 1; width < chunkCount; width *= 2) {
+            auto merge = [&](size_t pair) {
+                const size_t left = pair * 2 * width;
+                std::inplace_merge(offset(left), offset(left + width), offset(left + 2 * width), comp);
+            };
+            Detail::RunChunks(loop, (chunkCount - width + 2 * width - 1) / (2 * width), merge);
+        }
+    }
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
+
+#endif // WALRUS_PARALLEL_H
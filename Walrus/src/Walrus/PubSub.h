@@ -1,6 +1,8 @@
 #ifndef WALRUS_PUBSUB_H
 #define WALRUS_PUBSUB_H
 
+#include "UniqueFunction.h"
+
 #include <functional>
 #include <string>
 #include <memory>
@@ -54,8 +56,8 @@ namespace Walrus {
     template<typename T>
     using MessageHandler = std::function<void(const Message<T>&)>;
 
-    // Generic callback for type-erased messages
-    using GenericMessageHandler = std::function<void(const std::shared_ptr<BaseMessage>&)>;
+    // Generic callback for type-erased messages (move-only, small handlers are stored inline)
+    using GenericMessageHandler = UniqueFunction<void(const std::shared_ptr<BaseMessage>&)>;
 
     // Abstract broker interface for extensibility
     class IBroker {
@@ -65,7 +67,7 @@ namespace Walrus {
         // Subscribe to messages of a specific type on a topic
         template<typename T>
         void Subscribe(const std::string& topic, MessageHandler<T> handler) {
-            auto genericHandler = [handler](const std::shared_ptr<BaseMessage>& baseMsg) {
+            auto genericHandler = [handler = std::move(handler)](const std::shared_ptr<BaseMessage>& baseMsg) {
                 if (baseMsg->GetType() == typeid(T)) {
                     try {
                         auto data = std::any_cast<T>(baseMsg->GetRawData());
@@ -76,7 +78,7 @@ namespace Walrus {
                     }
                 }
             };
-            SubscribeInternal(topic, typeid(T), genericHandler);
+            SubscribeInternal(topic, typeid(T), std::move(genericHandler));
         }
 
         // Publish a message to a topic
@@ -0,0 +1,71 @@
+#ifndef WALRUS_RINGQUEUE_H
+#define WALRUS_RINGQUEUE_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Walrus {
+
+    // FIFO queue on a growable power-of-two ring buffer. Unlike std::queue (std::deque) it keeps its
+    // storage once grown, so steady-state push/pop never allocates. Not thread-safe.
+    template<typename T>
+    class RingQueue {
+    public:
+        bool Empty() const { return m_Count == 0; }
+        size_t Size() const { return m_Count; }
+        size_t Capacity() const { return m_Buffer.size(); }
+
+        // Grow the buffer to hold at least capacity elements without reallocating
+        void Reserve(size_t capacity) {
+            while (m_Buffer.size() < capacity) {
+                Grow();
+            }
+        }
+
+        void Push(T value) {
+            if (m_Count == m_Buffer.size()) {
+                Grow();
+            }
+            m_Buffer[(m_Head + m_Count) & (m_Buffer.size() - 1)] = std::move(value);
+            m_Count++;
+        }
+
+        // Removes and returns the oldest element, the queue must not be empty
+        T Pop() {
+            T value = std::move(m_Buffer[m_Head]);
+            m_Buffer[m_Head] = T(); // Release whatever the moved-from element still holds
+            m_Head = (m_Head + 1) & (m_Buffer.size() - 1);
+            m_Count--;
+            return value;
+        }
+
+        // Removes and returns the newest element, the queue must not be empty.
+        // Together with Pop() this makes the queue usable as a double-ended work queue.
+        T PopBack() {
+            const size_t index = (m_Head + m_Count - 1) & (m_Buffer.size() - 1);
+            T value = std::move(m_Buffer[index]);
+            m_Buffer[index] = T();
+            m_Count--;
+            return value;
+        }
+
+    private:
+        void Grow() {
+            std::vector<T> buffer(m_Buffer.empty() ? 16 : m_Buffer.size() * 2);
+            for (size_t i = 0; i < m_Count; ++i) {
+                buffer[i] = std::move(m_Buffer[(m_Head + i) & (m_Buffer.size() - 1)]);
+            }
+            m_Buffer = std::move(buffer);
+            m_Head = 0;
+        }
+
+    private:
+        std::vector<T> m_Buffer;
+        size_t m_Head = 0;
+        size_t m_Count = 0;
+    };
+
+} // namespace Walrus
+
+#endif // WALRUS_RINGQUEUE_H
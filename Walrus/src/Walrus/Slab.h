@@ -0,0 +1,93 @@
+#ifndef WALRUS_SLAB_H
+#define WALRUS_SLAB_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Walrus {
+
+    // Pool of records addressed by stable 32-bit indices. Released records go onto a free list
+    // and are reused before the pool grows, so once it has reached its working size acquiring a
+    // record does not allocate. References are invalidated when the pool grows, indices are not.
+    // Every record carries a generation that changes on release, so an (index, generation) pair
+    // identifies one use of a record and stale pairs are detected in O(1). Not thread-safe.
+    template<typename T>
+    class Slab {
+    public:
+        static constexpr uint32_t InvalidIndex = UINT32_MAX;
+        static constexpr uint32_t MaxGeneration = 0x7FFFFFFF; // Generations are 1..MaxGeneration (31 bits)
+
+        explicit Slab(size_t capacity = 0) { Reserve(capacity); }
+
+        // Preallocate records up to capacity and put them on the free list
+        void Reserve(size_t capacity) {
+            while (m_Entries.size() < capacity) {
+                m_Entries.emplace_back();
+                m_Entries.back().nextFree = m_FreeHead;
+                m_FreeHead = static_cast<uint32_t>(m_Entries.size() - 1);
+            }
+        }
+
+        // Index of a default-constructed record
+        uint32_t Acquire() {
+            uint32_t index;
+            if (m_FreeHead != InvalidIndex) {
+                index = m_FreeHead;
+                m_FreeHead = m_Entries[index].nextFree;
+            } else {
+                index = static_cast<uint32_t>(m_Entries.size());
+                m_Entries.emplace_back();
+            }
+
+            m_Entries[index].nextFree = InvalidIndex;
+            m_Entries[index].used = true;
+            m_Live++;
+            m_HighWater = std::max(m_HighWater, m_Live);
+            return index;
+        }
+
+        // Reset the record (dropping whatever it owns) and recycle its index
+        void Release(uint32_t index) {
+            Entry& entry = m_Entries[index];
+            entry.value = T();
+            entry.used = false;
+            entry.generation = entry.generation == MaxGeneration ? 1 : entry.generation + 1;
+            entry.nextFree = m_FreeHead;
+            m_FreeHead = index;
+            m_Live--;
+        }
+
+        // Generation of the record's current (or next, while free) use
+        uint32_t Generation(uint32_t index) const { return m_Entries[index].generation; }
+
+        // True if index is in use and still holds the use identified by generation
+        bool Contains(uint32_t index, uint32_t generation) const {
+            return index < m_Entries.size() && m_Entries[index].used && m_Entries[index].generation == generation;
+        }
+
+        T& operator[](uint32_t index) { return m_Entries[index].value; }
+        const T& operator[](uint32_t index) const { return m_Entries[index].value; }
+
+        size_t Size() const { return m_Live; }
+        size_t Capacity() const { return m_Entries.size(); }
+        size_t HighWater() const { return m_HighWater; } // Most records live at the same time
+
+    private:
+        struct Entry {
+            T value{};
+            uint32_t nextFree = InvalidIndex;
+            uint32_t generation = 1;
+            bool used = false;
+        };
+
+        std::vector<Entry> m_Entries;
+        uint32_t m_FreeHead = InvalidIndex;
+        size_t m_Live = 0;
+        size_t m_HighWater = 0;
+    };
+
+} // namespace Walrus
+
+#endif // WALRUS_SLAB_H
@@ -0,0 +1,88 @@
+#include "Strand.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include <iostream>
+#include <thread>
+
+namespace Walrus {
+
+    namespace {
+
+        // Strand whose tasks the current thread is running, if any
+        thread_local const void* t_CurrentStrand = nullptr;
+
+    } // namespace
+
+    Strand::State::State(EventLoop& eventLoop)
+        : loop(&eventLoop)
+    {
+    }
+
+    Strand::Strand(EventLoop& loop)
+        : m_State(std::make_shared<State>(loop))
+    {
+    }
+
+    void Strand::Post(EventCallback callback) {
+        Enqueue(m_State, std::move(callback));
+    }
+
+    EventCallback Strand::Wrap(EventCallback callback) const {
+        // Both captures are shared_ptrs, so the wrapper and every task it posts fit UniqueFunction inline
+        return [state = m_State, shared = std::make_shared<EventCallback>(std::move(callback))]() {
+            Enqueue(state, [shared]() { (*shared)(); });
+        };
+    }
+
+    bool Strand::RunningInThisThread() const {
+        return t_CurrentStrand == m_State.get();
+    }
+
+    void Strand::Enqueue(const std::shared_ptr<State>& state, EventCallback callback) {
+        uint32_t generation;
+        state->tasks.Push(std::move(callback), generation);
+
+        // Whoever takes the count off zero owns the strand until a drain brings it back to zero
+        if (state->count.fetch_add(1, std::memory_order_acq_rel) == 0) {
+            Schedule(state);
+        }
+    }
+
+    void Strand::Schedule(const std::shared_ptr<State>& state) {
+        state->loop->PostContinuation([state]() { Drain(state); });
+    }
+
+    void Strand::Drain(const std::shared_ptr<State>& state) {
+        const void* previous = t_CurrentStrand;
+        t_CurrentStrand = state.get();
+
+        EventCallback task;
+        for (uint32_t ran = 0; ran < DrainBatch; ++ran) {
+            while (!state->tasks.Pop(task)) {
+                std::this_thread::yield(); // Counted by a poster that is still linking an earlier push
+            }
+
+            try {
+                task();
+            } catch (const std::exception& e) {
+                std::cerr << "EventLoop: Exception in callback: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "EventLoop: Unknown exception in callback" << std::endl;
+            }
+            task = nullptr;
+
+            if (state->count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                t_CurrentStrand = previous;
+                return; // Drained, the next Post schedules a new drain
+            }
+        }
+
+        // Still busy: give the worker back to other pool tasks and continue in a new drain
+        t_CurrentStrand = previous;
+        Schedule(state);
+    }
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
@@ -0,0 +1,60 @@
+#ifndef WALRUS_STRAND_H
+#define WALRUS_STRAND_H
+
+#include "Config.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include "EventLoop.h"
+#include "MpscQueue.h"
+
+#include <atomic>
+#include <memory>
+
+namespace Walrus {
+
+    // Serial executor on top of an EventLoop's thread pool.
+    // Tasks posted to a strand run one at a time in posting order, so state touched only from
+    // one strand needs no lock. No worker ever blocks on a strand: tasks go into a lock-free
+    // queue, and the poster that finds the strand idle schedules one pool task that drains it.
+    // While it is busy, further posts only enqueue. Different strands run in parallel.
+    // Strand is a cheap handle; copies refer to the same strand and queued tasks keep it alive.
+    class Strand {
+    public:
+        // Tasks a drain runs before it yields the worker to other pool tasks and requeues itself
+        static constexpr uint32_t DrainBatch = 64;
+
+        explicit Strand(EventLoop& loop);
+
+        // Run callback after every task posted to this strand before it, never concurrently with them
+        void Post(EventCallback callback);
+
+        // Callable that posts callback to this strand each time it is invoked, e.g. for
+        // SetInterval(strand.Wrap(...), ...). Invoking it does not allocate.
+        EventCallback Wrap(EventCallback callback) const;
+
+        // True when called from a task that this strand is running
+        bool RunningInThisThread() const;
+
+    private:
+        struct State {
+            EventLoop* loop = nullptr;
+            MpscQueue<EventCallback> tasks;
+            std::atomic<size_t> count{0}; // Posted but not finished; the poster that raises it from 0 schedules the drain
+
+            explicit State(EventLoop& eventLoop);
+        };
+
+        static void Enqueue(const std::shared_ptr<State>& state, EventCallback callback);
+        static void Schedule(const std::shared_ptr<State>& state);
+        static void Drain(const std::shared_ptr<State>& state);
+
+    private:
+        std::shared_ptr<State> m_State;
+    };
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
+
+#endif // WALRUS_STRAND_H
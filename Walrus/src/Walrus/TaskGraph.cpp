@@ -0,0 +1,200 @@
+#include "TaskGraph.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include <algorithm>
+#include <iostream>
+
+namespace Walrus {
+
+    TaskGraph::~TaskGraph() {
+        Wait();
+    }
+
+    TaskGraph::NodeId TaskGraph::Add(EventCallback task, TaskPriority priority) {
+        if (IsRunning()) {
+            std::cerr << "TaskGraph: Cannot add a task while the graph runs" << std::endl;
+            return InvalidNode;
+        }
+
+        Node node;
+        node.task = std::move(task);
+        node.priority = priority;
+        m_Nodes.push_back(std::move(node));
+        m_Prepared = false;
+        return m_Nodes.size() - 1;
+    }
+
+    void TaskGraph::RunAfter(NodeId task, NodeId predecessor) {
+        if (IsRunning()) {
+            std::cerr << "TaskGraph: Cannot add a dependency while the graph runs" << std::endl;
+            return;
+        }
+        if (task >= m_Nodes.size() || predecessor >= m_Nodes.size()) {
+            std::cerr << "TaskGraph: Dependency between unknown tasks ignored" << std::endl;
+            return;
+        }
+
+        auto& successors = m_Nodes[predecessor].successors;
+        if (std::find(successors.begin(), successors.end(), task) == successors.end()) {
+            successors.push_back(task);
+            m_Prepared = false;
+        }
+    }
+
+    void TaskGraph::RunAfter(NodeId task, std::initializer_list<NodeId> predecessors) {
+        for (NodeId predecessor : predecessors) {
+            RunAfter(task, predecessor);
+        }
+    }
+
+    bool TaskGraph::Run(EventLoop& loop, EventCallback onComplete) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Running) {
+                std::cerr << "TaskGraph: Run ignored, the previous run has not finished" << std::endl;
+                return false;
+            }
+            if (!Prepare()) {
+                std::cerr << "TaskGraph: Run ignored, the graph has a cycle" << std::endl;
+                return false;
+            }
+            m_Running = true;
+        }
+
+        m_Loop = &loop;
+        m_OnComplete = std::move(onComplete);
+        for (size_t i = 0; i < m_Nodes.size(); ++i) {
+            m_Pending[i].store(m_Nodes[i].predecessors, std::memory_order_relaxed);
+        }
+        m_Remaining.store(m_Nodes.size(), std::memory_order_relaxed);
+
+        if (m_Nodes.empty()) {
+            Finish();
+            return true;
+        }
+
+        // Posting orders the stores above before the tasks
+        for (NodeId root : m_Roots) {
+            Schedule(root);
+        }
+        return true;
+    }
+
+    void TaskGraph::Wait() {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Finished.wait(lock, [this] { return !m_Running; });
+    }
+
+    bool TaskGraph::IsRunning() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Running;
+    }
+
+    bool TaskGraph::Prepare() {
+        if (m_Prepared) {
+            return true;
+        }
+
+        for (Node& node : m_Nodes) {
+            node.predecessors = 0;
+        }
+        for (const Node& node : m_Nodes) {
+            for (NodeId successor : node.successors) {
+                m_Nodes[successor].predecessors++;
+            }
+        }
+
+        m_Roots.clear();
+        for (NodeId i = 0; i < m_Nodes.size(); ++i) {
+            if (m_Nodes[i].predecessors == 0) {
+                m_Roots.push_back(i);
+            }
+        }
+
+        // Kahn's algorithm: every node is reached from the roots exactly when there is no cycle
+        std::vector<uint32_t> remaining(m_Nodes.size());
+        for (NodeId i = 0; i < m_Nodes.size(); ++i) {
+            remaining[i] = m_Nodes[i].predecessors;
+        }
+        std::vector<NodeId> ready(m_Roots);
+        size_t visited = 0;
+        while (!ready.empty()) {
+            NodeId node = ready.back();
+            ready.pop_back();
+            visited++;
+            for (NodeId successor : m_Nodes[node].successors) {
+                if (--remaining[successor] == 0) {
+                    ready.push_back(successor);
+                }
+            }
+        }
+        if (visited != m_Nodes.size()) {
+            return false;
+        }
+
+        m_Pending = std::make_unique<std::atomic<uint32_t>[]>(m_Nodes.size());
+        m_Prepared = true;
+        return true;
+    }
+
+    void TaskGraph::Schedule(NodeId node) {
+        m_Loop->PostContinuation([this, node]() { Execute(node); }, m_Nodes[node].priority);
+    }
+
+    void TaskGraph::Execute(NodeId node) {
+        for (;;) {
+            const Node& current = m_Nodes[node];
+            try {
+                current.task();
+            } catch (const std::exception& e) {
+                std::cerr << "TaskGraph: Exception in task: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "TaskGraph: Unknown exception in task" << std::endl;
+            }
+
+            // The last predecessor to finish releases a task; keep the first one released in this
+            // task's lane, post the rest so each is queued in its own lane
+            NodeId next = InvalidNode;
+            for (NodeId successor : current.successors) {
+                if (m_Pending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    if (next == InvalidNode && m_Nodes[successor].priority == current.priority) {
+                        next = successor;
+                    } else {
+                        Schedule(successor);
+                    }
+                }
+            }
+
+            if (m_Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                Finish(); // The graph may be gone once Finish returns
+                return;
+            }
+            if (next == InvalidNode) {
+                return;
+            }
+            node = next;
+        }
+    }
+
+    void TaskGraph::Finish() {
+        // The run ends after onComplete, so Wait() cannot return and Run() cannot replace it meanwhile
+        if (m_OnComplete) {
+            try {
+                m_OnComplete();
+            } catch (const std::exception& e) {
+                std::cerr << "TaskGraph: Exception in completion callback: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "TaskGraph: Unknown exception in completion callback" << std::endl;
+            }
+            m_OnComplete = nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Running = false;
+        m_Finished.notify_all(); // The graph may be gone once the lock is released
+    }
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
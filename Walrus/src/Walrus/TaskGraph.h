@@ -0,0 +1,89 @@
+#ifndef WALRUS_TASKGRAPH_H
+#define WALRUS_TASKGRAPH_H
+
+#include "Config.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include "EventLoop.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Walrus {
+
+    // Directed acyclic graph of tasks, built once and run any number of times on an EventLoop's pool.
+    // A task starts as soon as the last of its predecessors finishes: the worker that finished it
+    // goes on with one newly ready successor of the same priority itself and posts the others
+    // straight to the pool in their own lanes, so no edge goes through the loop thread. Rerunning
+    // a graph that has not changed allocates nothing. The graph cannot be changed while it runs,
+    // and one run must finish before the next starts.
+    class TaskGraph {
+    public:
+        using NodeId = size_t;
+        static constexpr NodeId InvalidNode = static_cast<NodeId>(-1);
+
+        TaskGraph() = default;
+        ~TaskGraph(); // Waits for a run in progress
+
+        TaskGraph(const TaskGraph&) = delete;
+        TaskGraph& operator=(const TaskGraph&) = delete;
+
+        // Add a task without dependencies. The callback is invoked once per run and kept.
+        // Returns InvalidNode while the graph runs.
+        NodeId Add(EventCallback task, TaskPriority priority = TaskPriority::Normal);
+
+        // task runs after predecessor (or after all of predecessors) in every run
+        void RunAfter(NodeId task, NodeId predecessor);
+        void RunAfter(NodeId task, std::initializer_list<NodeId> predecessors);
+
+        // Start a run on loop's pool and return at once. onComplete, if given, runs on the worker
+        // that finishes the last task, and the run ends when it returns: Wait() returns after it, and
+        // it cannot start the next run of this graph itself. Returns false if a run is still in
+        // progress or the graph has a cycle; nothing runs then. A task that throws is logged and its
+        // successors still run.
+        bool Run(EventLoop& loop, EventCallback onComplete = nullptr);
+
+        // Block until the current run, if any, has finished. Not from a task of this graph.
+        void Wait();
+
+        bool IsRunning() const;
+        size_t GetTaskCount() const { return m_Nodes.size(); }
+
+    private:
+        struct Node {
+            EventCallback task;
+            TaskPriority priority = TaskPriority::Normal;
+            std::vector<NodeId> successors;
+            uint32_t predecessors = 0;
+        };
+
+        bool Prepare();
+        void Schedule(NodeId node);
+        void Execute(NodeId node);
+        void Finish();
+
+    private:
+        std::vector<Node> m_Nodes;
+        std::vector<NodeId> m_Roots;                       // Nodes without predecessors, valid once prepared
+        std::unique_ptr<std::atomic<uint32_t>[]> m_Pending; // Per node: predecessors not finished in this run
+        bool m_Prepared = false;                            // Cleared by any change to the graph
+
+        EventLoop* m_Loop = nullptr;                        // Loop of the current run
+        EventCallback m_OnComplete;
+        std::atomic<size_t> m_Remaining{0};                 // Tasks of the current run not finished
+
+        mutable std::mutex m_Mutex;
+        std::condition_variable m_Finished;
+        bool m_Running = false;                             // Guarded by m_Mutex
+    };
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
+
+#endif // WALRUS_TASKGRAPH_H
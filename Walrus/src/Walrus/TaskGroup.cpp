@@ -0,0 +1,63 @@
+#include "TaskGroup.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include <thread>
+
+namespace Walrus {
+
+    TaskGroup::~TaskGroup() {
+        try {
+            Wait();
+        } catch (...) {
+        }
+    }
+
+    void TaskGroup::Wait() {
+        // Help from a worker: its children are most likely at the back of its own deque
+        if (m_Loop.IsWorkerThread()) {
+            uint32_t idle = 0;
+            while (m_Pending.load(std::memory_order_acquire) != 0) {
+                if (m_Loop.RunPendingTask()) {
+                    idle = 0;
+                } else if (++idle <= HelpSpins) {
+                    std::this_thread::yield(); // The remaining children are running elsewhere
+                } else {
+                    std::unique_lock<std::mutex> lock(m_Mutex);
+                    m_Done.wait_for(lock, HelpRecheck, [this] { return m_Pending.load(std::memory_order_acquire) == 0; });
+                }
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Done.wait(lock, [this] { return m_Pending.load(std::memory_order_acquire) == 0; });
+
+        if (m_Exception) {
+            std::rethrow_exception(std::exchange(m_Exception, nullptr));
+        }
+    }
+
+    void TaskGroup::Fail(std::exception_ptr exception) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_Exception) {
+            m_Exception = std::move(exception);
+        }
+    }
+
+    void TaskGroup::Complete() {
+        size_t pending = m_Pending.load(std::memory_order_relaxed);
+        while (pending > 1) {
+            if (m_Pending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+
+        // Possibly the last child: finish under the mutex (see m_Mutex)
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Pending.fetch_sub(1, std::memory_order_acq_rel);
+        m_Done.notify_all();
+    }
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
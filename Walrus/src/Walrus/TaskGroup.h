@@ -0,0 +1,86 @@
+#ifndef WALRUS_TASKGROUP_H
+#define WALRUS_TASKGROUP_H
+
+#include "Config.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include "EventLoop.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace Walrus {
+
+    // Fork/join on an EventLoop's pool. Run() forks tasks, Wait() joins them. A pool worker that
+    // waits runs other queued pool tasks (usually the group's own children, which it pushed to its
+    // own deque) until its children are done. A waiting task therefore never takes a thread away
+    // from the pool, and recursive divide and conquer cannot deadlock it even when every worker
+    // waits. Other threads just block in Wait().
+    //
+    //     int Fib(EventLoop& loop, int n) {
+    //         if (n < 20) return SerialFib(n);
+    //         int a, b;
+    //         TaskGroup group(loop);
+    //         group.Run([&]() { a = Fib(loop, n - 1); });
+    //         b = Fib(loop, n - 2);
+    //         group.Wait();
+    //         return a + b;
+    //     }
+    class TaskGroup {
+    public:
+        explicit TaskGroup(EventLoop& loop) : m_Loop(loop) {}
+        ~TaskGroup(); // Waits for the children; an exception they threw is dropped
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        // Fork function as a child task. Small callables are stored without allocating.
+        template<typename Function>
+        void Run(Function&& function, TaskPriority priority = TaskPriority::Normal) {
+            m_Pending.fetch_add(1, std::memory_order_relaxed);
+            m_Loop.PostContinuation([this, function = std::decay_t<Function>(std::forward<Function>(function))]() mutable {
+                try {
+                    function();
+                } catch (...) {
+                    Fail(std::current_exception());
+                }
+                Complete();
+            }, priority);
+        }
+
+        // Join: return once every child forked so far has finished (children may fork more), then
+        // rethrow the first exception a child threw. The group can be reused afterwards.
+        void Wait();
+
+    private:
+        void Fail(std::exception_ptr exception);
+        void Complete();
+
+    private:
+        // A helping worker that finds nothing to run yields this many times, then sleeps until the
+        // last child finishes. It wakes every HelpRecheck to look for work again, because children
+        // may queue tasks that no other worker is free to run.
+        static constexpr uint32_t HelpSpins = 64;
+        static constexpr std::chrono::microseconds HelpRecheck{200};
+
+        EventLoop& m_Loop;
+        std::atomic<size_t> m_Pending{0}; // Children not finished
+
+        // The last child finishes under m_Mutex and signals m_Done, so a waiter that takes it after
+        // seeing no pending children knows that no child touches the group anymore
+        std::mutex m_Mutex;
+        std::condition_variable m_Done;
+        std::exception_ptr m_Exception; // Guarded by m_Mutex
+    };
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
+
+#endif // WALRUS_TASKGROUP_H
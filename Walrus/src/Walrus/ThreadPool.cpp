@@ -0,0 +1,736 @@
+#include "ThreadPool.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include <algorithm>
+#include <iostream>
+
+#if defined(WL_PLATFORM_LINUX) || defined(WL_PLATFORM_MACOS)
+#include <pthread.h>
+#elif defined(WL_PLATFORM_WINDOWS)
+#include <windows.h>
+#endif
+
+namespace Walrus {
+
+    namespace {
+
+        // Identifies the pool worker running on this thread, if any
+        struct CurrentWorker {
+            const ThreadPool* pool = nullptr;
+            int index = -1;
+        };
+
+        thread_local CurrentWorker t_CurrentWorker;
+
+        int64_t SteadyNanoseconds() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // Heap order for std::push_heap/pop_heap: "less" means later, so the front is the earliest deadline
+        template<typename Task>
+        bool LaterDeadline(const Task& a, const Task& b) {
+            return a.deadline != b.deadline ? a.deadline > b.deadline : a.sequence > b.sequence;
+        }
+
+    } // namespace
+
+    // std::thread cannot set a stack size, so workers that need one are created with the platform API
+    struct ThreadPool::NativeThread {
+#if defined(WL_PLATFORM_LINUX) || defined(WL_PLATFORM_MACOS)
+        pthread_t handle;
+#elif defined(WL_PLATFORM_WINDOWS)
+        HANDLE handle;
+#endif
+    };
+
+    namespace {
+
+        struct LaunchContext {
+            ThreadPool* pool;
+            size_t index;
+            void (ThreadPool::*entry)(size_t);
+        };
+
+        void RunLaunchContext(void* argument) {
+            std::unique_ptr<LaunchContext> context(static_cast<LaunchContext*>(argument));
+            (context->pool->*context->entry)(context->index);
+        }
+
+    } // namespace
+
+    ThreadPool::Worker::~Worker() = default;
+
+    ThreadPool::ThreadPool(const ThreadPoolSpecification& specification)
+        : m_Specification(specification)
+    {
+        size_t threadCount = specification.ThreadCount;
+        if (threadCount == 0) {
+            threadCount = std::max(2u, std::thread::hardware_concurrency());
+        }
+
+        const size_t maxThreads = std::max<size_t>(specification.MaxThreads != 0 ? specification.MaxThreads : threadCount, 1);
+        const bool lazy = specification.LazyThreads || specification.AdaptiveThreads;
+        m_InitialWorkers = lazy ? std::min(std::max<size_t>(specification.MinThreads, 1), maxThreads)
+                                                     : std::min(threadCount, maxThreads);
+
+        // Every deque exists up front so workers can steal from each other as soon as they run
+        m_Workers.reserve(maxThreads);
+        for (size_t i = 0; i < maxThreads; ++i) {
+            m_Workers.push_back(std::make_unique<Worker>());
+        }
+    }
+
+    ThreadPool::ThreadPool(size_t threadCount)
+        : ThreadPool([threadCount]() {
+              ThreadPoolSpecification specification;
+              specification.ThreadCount = threadCount;
+              return specification;
+          }())
+    {
+        Start();
+    }
+
+    ThreadPool::~ThreadPool() {
+        Shutdown();
+    }
+
+    void ThreadPool::Start() {
+        std::lock_guard<std::mutex> launchLock(m_LaunchMutex);
+        if (!m_Stopping.load()) {
+            return; // Already running
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_SleepMutex);
+            m_Stopping.store(false);
+        }
+
+        for (size_t i = 0; i < m_InitialWorkers; ++i) {
+            LaunchWorker(i);
+        }
+
+        const int64_t now = SteadyNanoseconds();
+        m_LastResize.store(now);
+        StartWindow(m_InitialWorkers, now);
+    }
+
+    void ThreadPool::LaunchWorker(size_t index) {
+        Worker& worker = *m_Workers[index];
+
+        // A retired worker's thread exits right after handing off its deque
+        JoinWorker(worker);
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.retired = false;
+        }
+
+        // Publish first: the new worker steals from (and submitters target) workers [0, m_ActiveWorkers)
+        m_ActiveWorkers.store(index + 1, std::memory_order_release);
+
+        bool launched = false;
+        if (m_Specification.StackSize != 0) {
+            auto context = std::make_unique<LaunchContext>(LaunchContext{ this, index, &ThreadPool::WorkerThread });
+            auto nativeThread = std::make_unique<NativeThread>();
+
+#if defined(WL_PLATFORM_LINUX) || defined(WL_PLATFORM_MACOS)
+            pthread_attr_t attributes;
+            pthread_attr_init(&attributes);
+            if (pthread_attr_setstacksize(&attributes, m_Specification.StackSize) == 0) {
+                auto entry = [](void* argument) -> void* {
+                    RunLaunchContext(argument);
+                    return nullptr;
+                };
+                launched = pthread_create(&nativeThread->handle, &attributes, entry, context.get()) == 0;
+            }
+            pthread_attr_destroy(&attributes);
+#elif defined(WL_PLATFORM_WINDOWS)
+            auto entry = [](LPVOID argument) -> DWORD {
+                RunLaunchContext(argument);
+                return 0;
+            };
+            nativeThread->handle = CreateThread(nullptr, m_Specification.StackSize, entry, context.get(),
+                                                STACK_SIZE_PARAM_IS_A_RESERVATION, nullptr);
+            launched = nativeThread->handle != nullptr;
+#endif
+
+            if (launched) {
+                context.release(); // Owned by the thread now
+                worker.nativeThread = std::move(nativeThread);
+            } else {
+                std::cerr << "ThreadPool: Cannot create a worker with a " << m_Specification.StackSize
+                          << " byte stack, using the default stack size" << std::endl;
+            }
+        }
+
+        if (!launched) {
+            worker.thread = std::thread(&ThreadPool::WorkerThread, this, index);
+        }
+    }
+
+    void ThreadPool::JoinWorker(Worker& worker) {
+        if (worker.thread.joinable()) {
+            worker.thread.join();
+        }
+
+        if (worker.nativeThread) {
+#if defined(WL_PLATFORM_LINUX) || defined(WL_PLATFORM_MACOS)
+            pthread_join(worker.nativeThread->handle, nullptr);
+#elif defined(WL_PLATFORM_WINDOWS)
+            WaitForSingleObject(worker.nativeThread->handle, INFINITE);
+            CloseHandle(worker.nativeThread->handle);
+#endif
+            worker.nativeThread.reset();
+        }
+    }
+
+    void ThreadPool::GrowIfBusy(std::chrono::nanoseconds waited) {
+        // Lazy pools add a worker while more tasks are queued than there are idle workers to take them
+        if (!(m_Specification.LazyThreads || m_Specification.AdaptiveThreads) || m_Pending.load() <= m_Sleepers.load() ||
+            m_ActiveWorkers.load(std::memory_order_acquire) >= m_Workers.size()) {
+            return;
+        }
+
+        // Adaptive pools only once that has lasted GrowWait, or a task started after waiting that long
+        int64_t now = 0;
+        if (m_Specification.AdaptiveThreads) {
+            const int64_t growWait = std::chrono::duration_cast<std::chrono::nanoseconds>(m_Specification.GrowWait).count();
+            now = SteadyNanoseconds();
+            // Only the first to see saturation writes, the others just read the shared timestamp
+            int64_t since = m_SaturatedSince.load();
+            if (since == 0 && m_SaturatedSince.compare_exchange_strong(since, now)) {
+                since = now;
+            }
+            if ((waited.count() < growWait && now - since < growWait) || now - m_LastResize.load() < growWait) {
+                return;
+            }
+        }
+
+        // Never wait here: Shutdown holds the mutex while it joins workers that may be submitting
+        std::unique_lock<std::mutex> launchLock(m_LaunchMutex, std::try_to_lock);
+        if (!launchLock.owns_lock()) {
+            return;
+        }
+
+        const size_t active = m_ActiveWorkers.load(std::memory_order_relaxed);
+        if (m_Stopping.load() || active >= m_Workers.size()) {
+            return;
+        }
+        LaunchWorker(active);
+        m_WorkersAdded.fetch_add(1, std::memory_order_relaxed);
+
+        if (m_Specification.AdaptiveThreads) {
+            m_SaturatedSince.store(0);
+            m_LastResize.store(now);
+            StartWindow(active + 1, now);
+        }
+    }
+
+    bool ThreadPool::TryRetire(size_t index) {
+        std::unique_lock<std::mutex> launchLock(m_LaunchMutex, std::try_to_lock);
+        if (!launchLock.owns_lock()) {
+            return false;
+        }
+
+        // Only the last worker retires, so the running ones stay [0, m_ActiveWorkers)
+        const size_t active = m_ActiveWorkers.load(std::memory_order_relaxed);
+        const int64_t now = SteadyNanoseconds();
+        const int64_t window = now - m_WindowStart;
+        if (m_Stopping.load() || index + 1 != active || active <= m_InitialWorkers ||
+            window < std::chrono::duration_cast<std::chrono::nanoseconds>(m_Specification.ShrinkWindow).count()) {
+            return false;
+        }
+
+        const uint64_t idle = IdleTime(active, now);
+        const double ratio = static_cast<double>(idle - std::min(idle, m_WindowIdle)) / (static_cast<double>(active) * window);
+        if (ratio < m_Specification.ShrinkIdleRatio) {
+            StartWindow(active, now);
+            return false;
+        }
+
+        m_ActiveWorkers.store(index, std::memory_order_release);
+        m_WorkersRetired.fetch_add(1, std::memory_order_relaxed);
+        m_LastResize.store(now);
+        StartWindow(index, now);
+        launchLock.unlock();
+
+        // Hand what is still queued here to worker 0, which never retires. Submitters that picked
+        // this deque before m_ActiveWorkers dropped see retired and go there too.
+        std::vector<QueuedTask> leftovers;
+        {
+            Worker& worker = *m_Workers[index];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.retired = true;
+            while (!worker.tasks.Empty()) {
+                leftovers.push_back(worker.tasks.Pop());
+            }
+        }
+        for (auto& task : leftovers) {
+            PushToWorker(0, std::move(task));
+        }
+        WakeWorkers(leftovers.size());
+        return true;
+    }
+
+    void ThreadPool::StartWindow(size_t workerCount, int64_t now) {
+        m_WindowStart = now;
+        m_WindowIdle = IdleTime(workerCount, now);
+    }
+
+    uint64_t ThreadPool::IdleTime(size_t workerCount, int64_t now) const {
+        uint64_t total = 0;
+        for (size_t i = 0; i < workerCount; ++i) {
+            const Worker& worker = *m_Workers[i];
+            total += worker.idleTime.load(std::memory_order_relaxed);
+            const int64_t since = worker.sleepingSince.load(std::memory_order_relaxed);
+            if (since != 0 && now > since) {
+                total += static_cast<uint64_t>(now - since);
+            }
+        }
+        return total;
+    }
+
+    void ThreadPool::Submit(EventCallback task, TaskPriority priority) {
+        QueuedTask queued{ std::move(task), std::chrono::steady_clock::now() };
+
+        // Counted before the task is visible, so a worker that takes it right away cannot take the count below zero
+        m_Pending.fetch_add(1);
+
+        const int self = GetCurrentWorkerIndex();
+        if (priority != TaskPriority::Normal) {
+            Lane& lane = GetLane(priority);
+            std::lock_guard<std::mutex> lock(lane.mutex);
+            lane.tasks.Push(std::move(queued));
+            lane.depth.store(lane.tasks.Size(), std::memory_order_release);
+        } else if (self >= 0) {
+            PushToWorker(static_cast<size_t>(self), std::move(queued));
+        } else if (!m_Injector.TryPush(std::move(queued))) {
+            PushToWorker(m_NextWorker.fetch_add(1, std::memory_order_relaxed) % std::max<size_t>(GetThreadCount(), 1),
+                         std::move(queued));
+        }
+
+        WakeWorkers(1);
+        GrowIfBusy();
+    }
+
+    void ThreadPool::PushToWorker(size_t index, QueuedTask task) {
+        {
+            Worker& worker = *m_Workers[index];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (!worker.retired) {
+                worker.tasks.Push(std::move(task));
+                return;
+            }
+        }
+        PushToWorker(0, std::move(task)); // Worker 0 never retires
+    }
+
+    void ThreadPool::Submit(std::vector<EventCallback>& tasks, TaskPriority priority) {
+        const size_t count = tasks.size();
+        if (count == 0) {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const int self = GetCurrentWorkerIndex();
+        m_Pending.fetch_add(count); // Before the tasks are visible, see Submit(EventCallback)
+        if (priority != TaskPriority::Normal) {
+            Lane& lane = GetLane(priority);
+            std::lock_guard<std::mutex> lock(lane.mutex);
+            for (auto& task : tasks) {
+                lane.tasks.Push({ std::move(task), now });
+            }
+            lane.depth.store(lane.tasks.Size(), std::memory_order_release);
+        } else if (self >= 0) {
+            // Keep them local, idle workers steal what this one cannot get to
+            Worker& worker = *m_Workers[self];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            for (auto& task : tasks) {
+                worker.tasks.Push({ std::move(task), now });
+            }
+        } else {
+            // Contiguous chunks, one lock per worker that receives any
+            const size_t workerCount = std::max<size_t>(GetThreadCount(), 1);
+            const size_t chunk = (count + workerCount - 1) / workerCount;
+            const size_t first = m_NextWorker.fetch_add(workerCount, std::memory_order_relaxed);
+
+            for (size_t begin = 0, offset = 0; begin < count; begin += chunk, ++offset) {
+                const size_t end = std::min(begin + chunk, count);
+                Worker& worker = *m_Workers[(first + offset) % workerCount];
+
+                std::unique_lock<std::mutex> lock(worker.mutex);
+                if (worker.retired) {
+                    lock.unlock();
+                    for (size_t i = begin; i < end; ++i) {
+                        PushToWorker(0, { std::move(tasks[i]), now });
+                    }
+                    continue;
+                }
+                for (size_t i = begin; i < end; ++i) {
+                    worker.tasks.Push({ std::move(tasks[i]), now });
+                }
+            }
+        }
+        tasks.clear();
+
+        WakeWorkers(count);
+        GrowIfBusy();
+    }
+
+    void ThreadPool::Submit(DeadlineTask task, TaskPriority priority) {
+        QueuedTask queued{ std::move(task.Callback), std::chrono::steady_clock::now() };
+        queued.deadline = task.Deadline;
+        queued.countMiss = task.CountMiss;
+
+        m_Pending.fetch_add(1); // Before the task is visible, see Submit(EventCallback)
+        {
+            DeadlineLane& lane = m_Deadlines[TaskLane(priority)];
+            std::lock_guard<std::mutex> lock(lane.mutex);
+            PushDeadline(lane, std::move(queued));
+        }
+
+        WakeWorkers(1);
+        GrowIfBusy();
+    }
+
+    void ThreadPool::Submit(std::vector<DeadlineTask>& tasks, TaskPriority priority) {
+        const size_t count = tasks.size();
+        if (count == 0) {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        m_Pending.fetch_add(count); // Before the tasks are visible, see Submit(EventCallback)
+        {
+            DeadlineLane& lane = m_Deadlines[TaskLane(priority)];
+            std::lock_guard<std::mutex> lock(lane.mutex);
+            for (auto& task : tasks) {
+                QueuedTask queued{ std::move(task.Callback), now };
+                queued.deadline = task.Deadline;
+                queued.countMiss = task.CountMiss;
+                PushDeadline(lane, std::move(queued));
+            }
+        }
+        tasks.clear();
+
+        WakeWorkers(count);
+        GrowIfBusy();
+    }
+
+    void ThreadPool::PushDeadline(DeadlineLane& lane, QueuedTask task) {
+        task.sequence = lane.nextSequence++;
+        lane.heap.push_back(std::move(task));
+        std::push_heap(lane.heap.begin(), lane.heap.end(), LaterDeadline<QueuedTask>);
+        lane.depth.store(lane.heap.size(), std::memory_order_release);
+    }
+
+    void ThreadPool::Shutdown() {
+        // Holding m_LaunchMutex keeps lazy growth from launching workers that would not be joined
+        std::lock_guard<std::mutex> launchLock(m_LaunchMutex);
+        {
+            std::lock_guard<std::mutex> lock(m_SleepMutex);
+            if (m_Stopping.exchange(true)) {
+                return;
+            }
+        }
+        m_SleepCondition.notify_all();
+        WakeTakenWaiters(true);
+
+        // Retired workers included, their threads have exited but were not joined
+        for (const auto& worker : m_Workers) {
+            JoinWorker(*worker);
+        }
+        m_ActiveWorkers.store(0, std::memory_order_release);
+    }
+
+    int ThreadPool::GetCurrentWorkerIndex() const {
+        return t_CurrentWorker.pool == this ? t_CurrentWorker.index : -1;
+    }
+
+    uint64_t ThreadPool::GetTasksExecuted() const {
+        uint64_t total = 0;
+        for (const auto& worker : m_Workers) {
+            total += worker->executed.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    uint64_t ThreadPool::GetTasksStolen() const {
+        uint64_t total = 0;
+        for (const auto& worker : m_Workers) {
+            total += worker->stolen.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    TaskLaneStats ThreadPool::GetLaneStats(TaskPriority priority) const {
+        const size_t lane = TaskLane(priority);
+        TaskLaneStats stats;
+
+        uint64_t wait = 0;
+        for (const auto& worker : m_Workers) {
+            stats.Executed += worker->laneExecuted[lane].load(std::memory_order_relaxed);
+            wait += worker->laneWait[lane].load(std::memory_order_relaxed);
+            stats.MaxWait = std::max(stats.MaxWait, std::chrono::nanoseconds(worker->laneMaxWait[lane].load(std::memory_order_relaxed)));
+        }
+        if (stats.Executed > 0) {
+            stats.AverageWait = std::chrono::nanoseconds(wait / stats.Executed);
+        }
+
+        // The normal lane has no counter of its own, it holds whatever the other two do not
+        const size_t critical = m_Critical.depth.load(std::memory_order_relaxed) +
+                                m_Deadlines[TaskLane(TaskPriority::Critical)].depth.load(std::memory_order_relaxed);
+        const size_t background = m_Background.depth.load(std::memory_order_relaxed) +
+                                  m_Deadlines[TaskLane(TaskPriority::Background)].depth.load(std::memory_order_relaxed);
+        if (priority == TaskPriority::Critical) {
+            stats.Depth = critical;
+        } else if (priority == TaskPriority::Background) {
+            stats.Depth = background;
+        } else {
+            const size_t pending = m_Pending.load(std::memory_order_relaxed);
+            stats.Depth = pending - std::min(pending, critical + background);
+        }
+        return stats;
+    }
+
+    DeadlineStats ThreadPool::GetDeadlineStats() const {
+        DeadlineStats stats;
+        for (const auto& worker : m_Workers) {
+            stats.Completed += worker->deadlineCompleted.load(std::memory_order_relaxed);
+            stats.Missed += worker->deadlineMissed.load(std::memory_order_relaxed);
+            stats.MaxLateness = std::max(stats.MaxLateness, std::chrono::nanoseconds(worker->maxLateness.load(std::memory_order_relaxed)));
+        }
+        return stats;
+    }
+
+    void ThreadPool::WorkerThread(size_t index) {
+        t_CurrentWorker.pool = this;
+        t_CurrentWorker.index = static_cast<int>(index);
+
+        while (true) {
+            if (RunNext(index)) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_SleepMutex);
+            if (m_Stopping.load() && m_Pending.load() == 0) {
+                break; // Drained
+            }
+
+            auto woken = [this] { return m_Pending.load() > 0 || m_Stopping.load(); };
+            if (!m_Specification.AdaptiveThreads) {
+                m_Sleepers.fetch_add(1);
+                m_SleepCondition.wait(lock, woken);
+                m_Sleepers.fetch_sub(1);
+                continue;
+            }
+
+            // Adaptive: an idle worker means nothing is waiting for one, and a sleep that lasts the
+            // whole window asks whether the pool idles enough to retire a worker
+            Worker& worker = *m_Workers[index];
+            const int64_t asleep = SteadyNanoseconds();
+            if (m_SaturatedSince.load() != 0) {
+                m_SaturatedSince.store(0);
+            }
+            worker.sleepingSince.store(asleep, std::memory_order_relaxed);
+            m_Sleepers.fetch_add(1);
+            const bool signalled = m_SleepCondition.wait_for(lock, m_Specification.ShrinkWindow, woken);
+            m_Sleepers.fetch_sub(1);
+            worker.sleepingSince.store(0, std::memory_order_relaxed);
+            worker.idleTime.fetch_add(static_cast<uint64_t>(SteadyNanoseconds() - asleep), std::memory_order_relaxed);
+
+            if (!signalled) {
+                lock.unlock();
+                if (TryRetire(index)) {
+                    break;
+                }
+            }
+        }
+
+        t_CurrentWorker = CurrentWorker();
+    }
+
+    bool ThreadPool::RunPendingTask() {
+        const int self = GetCurrentWorkerIndex();
+        return self >= 0 && RunNext(static_cast<size_t>(self));
+    }
+
+    bool ThreadPool::RunNext(size_t index) {
+        Worker& worker = *m_Workers[index];
+        const uint32_t tick = ++worker.tick;
+        const uint32_t starvationLimit = m_Specification.StarvationLimit;
+
+        // Lanes in the order this pick tries them. A fairness pick lets a lower lane go first.
+        TaskPriority order[TaskPriorityCount] = { TaskPriority::Critical, TaskPriority::Normal, TaskPriority::Background };
+        if (starvationLimit != 0 && tick % starvationLimit == 0) {
+            const bool backgroundTurn = (tick / starvationLimit) % 2 == 0;
+            order[0] = backgroundTurn ? TaskPriority::Background : TaskPriority::Normal;
+            order[1] = backgroundTurn ? TaskPriority::Normal : TaskPriority::Background;
+            order[2] = TaskPriority::Critical;
+        }
+
+        QueuedTask task;
+        for (TaskPriority priority : order) {
+            if (PopDeadline(priority, task) ||
+                (priority == TaskPriority::Normal ? PopNormal(index, tick, task) : PopLane(priority, task))) {
+                m_Pending.fetch_sub(1);
+                if (m_TakenWaiters.load() != 0) {
+                    WakeTakenWaiters(false); // One task taken makes room for one
+                }
+                Run(task, priority);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ThreadPool::PopDeadline(TaskPriority priority, QueuedTask& task) {
+        DeadlineLane& lane = m_Deadlines[TaskLane(priority)];
+        if (lane.depth.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(lane.mutex);
+        if (lane.heap.empty()) {
+            return false;
+        }
+        std::pop_heap(lane.heap.begin(), lane.heap.end(), LaterDeadline<QueuedTask>);
+        task = std::move(lane.heap.back());
+        lane.heap.pop_back();
+        lane.depth.store(lane.heap.size(), std::memory_order_release);
+        return true;
+    }
+
+    bool ThreadPool::PopLane(TaskPriority priority, QueuedTask& task) {
+        Lane& lane = GetLane(priority);
+        if (lane.depth.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(lane.mutex);
+        if (lane.tasks.Empty()) {
+            return false;
+        }
+        task = lane.tasks.Pop();
+        lane.depth.store(lane.tasks.Size(), std::memory_order_release);
+        return true;
+    }
+
+    bool ThreadPool::PopNormal(size_t index, uint32_t tick, QueuedTask& task) {
+        const bool injectorFirst = tick % InjectorPollInterval == 0;
+        return (injectorFirst && m_Injector.TryPop(task)) || PopLocal(*m_Workers[index], task) ||
+               m_Injector.TryPop(task) || Steal(index, task);
+    }
+
+    bool ThreadPool::PopLocal(Worker& worker, QueuedTask& task) {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.tasks.Empty()) {
+            return false;
+        }
+        task = worker.tasks.PopBack();
+        return true;
+    }
+
+    bool ThreadPool::Steal(size_t thief, QueuedTask& task) {
+        const size_t workerCount = GetThreadCount();
+        if (workerCount < 2) {
+            return false;
+        }
+
+        // Start at a different victim each time so idle workers do not all hit the same deque
+        thread_local size_t t_Seed = thief * 0x9E3779B97F4A7C15ull + 1;
+        t_Seed ^= t_Seed << 13;
+        t_Seed ^= t_Seed >> 7;
+        t_Seed ^= t_Seed << 17;
+        const size_t start = t_Seed % workerCount;
+
+        for (size_t i = 0; i < workerCount; ++i) {
+            const size_t victim = (start + i) % workerCount;
+            if (victim == thief) {
+                continue;
+            }
+
+            Worker& worker = *m_Workers[victim];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if (!worker.tasks.Empty()) {
+                task = worker.tasks.Pop();
+                m_Workers[thief]->stolen.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::Run(QueuedTask& task, TaskPriority priority) {
+        Worker& self = *m_Workers[t_CurrentWorker.index];
+        const size_t lane = TaskLane(priority);
+        const uint64_t wait = static_cast<uint64_t>(std::max<int64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - task.queued).count(), 0));
+
+        // Only this worker writes its counters, plain stores are enough
+        self.laneExecuted[lane].store(self.laneExecuted[lane].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        self.laneWait[lane].store(self.laneWait[lane].load(std::memory_order_relaxed) + wait, std::memory_order_relaxed);
+        if (wait > self.laneMaxWait[lane].load(std::memory_order_relaxed)) {
+            self.laneMaxWait[lane].store(wait, std::memory_order_relaxed);
+        }
+        if (m_Specification.AdaptiveThreads &&
+            (self.tick % GrowSampleInterval == 0 || std::chrono::nanoseconds(wait) >= m_Specification.GrowWait)) {
+            GrowIfBusy(std::chrono::nanoseconds(wait)); // Tasks behind this one have likely waited as long
+        }
+
+        try {
+            task.callback();
+        } catch (const std::exception& e) {
+            std::cerr << "EventLoop: Exception in callback: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "EventLoop: Unknown exception in callback" << std::endl;
+        }
+
+        if (task.countMiss) {
+            const int64_t lateness = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - task.deadline).count();
+
+            self.deadlineCompleted.store(self.deadlineCompleted.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (lateness > 0) {
+                self.deadlineMissed.store(self.deadlineMissed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                if (static_cast<uint64_t>(lateness) > self.maxLateness.load(std::memory_order_relaxed)) {
+                    self.maxLateness.store(static_cast<uint64_t>(lateness), std::memory_order_relaxed);
+                }
+            }
+            task.countMiss = false;
+        }
+
+        task.callback = nullptr; // Release captures before looking for the next task
+        self.executed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void ThreadPool::WakeTakenWaiters(bool all) {
+        { std::lock_guard<std::mutex> lock(m_TakenMutex); } // See WakeWorkers
+        if (all) {
+            m_TakenCondition.notify_all();
+        } else {
+            m_TakenCondition.notify_one();
+        }
+    }
+
+    void ThreadPool::WakeWorkers(size_t count) {
+        const size_t sleepers = m_Sleepers.load();
+        if (sleepers == 0) {
+            return;
+        }
+
+        // Pass through the mutex so a worker between its predicate check and wait() cannot miss this
+        { std::lock_guard<std::mutex> lock(m_SleepMutex); }
+
+        if (count >= sleepers) {
+            m_SleepCondition.notify_all();
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                m_SleepCondition.notify_one();
+            }
+        }
+    }
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
@@ -0,0 +1,279 @@
+#ifndef WALRUS_THREADPOOL_H
+#define WALRUS_THREADPOOL_H
+
+#include "Config.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include "TimerQueue.h"
+#include "RingQueue.h"
+#include "MpmcQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Walrus {
+
+    // Sizing and threading options for ThreadPool
+    struct ThreadPoolSpecification {
+        // Workers started by Start(); 0 = std::thread::hardware_concurrency() (at least 2)
+        size_t ThreadCount = 0;
+
+        // Lazy creation: Start() launches only MinThreads workers and more are added, up to
+        // MaxThreads, while more tasks are queued than there are idle workers
+        bool LazyThreads = false;
+        size_t MinThreads = 1;
+        size_t MaxThreads = 0; // 0 = ThreadCount
+
+        // Adaptive sizing: grows like LazyThreads and also retires idle workers, down to MinThreads.
+        // A worker is added once queued tasks have waited GrowWait with no idle worker to take them,
+        // at most one per GrowWait. One is retired when the workers were idle for ShrinkIdleRatio of
+        // the last ShrinkWindow or more. Every resize starts a new window, so a worker that was just
+        // added is not retired on the strength of the quiet time before the burst.
+        bool AdaptiveThreads = false;
+        std::chrono::microseconds GrowWait{1000};
+        std::chrono::milliseconds ShrinkWindow{2000};
+        double ShrinkIdleRatio = 0.75;
+
+        // Stack size of each worker thread in bytes, 0 = platform default
+        size_t StackSize = 0;
+
+        // Starvation protection: every StarvationLimit-th task a worker takes comes from a lower lane
+        // when one has work queued (alternating between Background and Normal), so a flood of higher
+        // priority tasks slows the lower lanes down instead of stopping them. 0 = strict priority.
+        uint32_t StarvationLimit = 16;
+    };
+
+    // A task that must complete by Deadline, for ThreadPool::Submit
+    struct DeadlineTask {
+        EventCallback Callback;
+        std::chrono::steady_clock::time_point Deadline;
+        bool CountMiss = true; // False when the deadline only orders the task (timers under EventLoopSpecification::TimerDeadlines)
+    };
+
+    // Completion of tasks submitted with a deadline that counts
+    struct DeadlineStats {
+        uint64_t Completed = 0;
+        uint64_t Missed = 0;                     // Completed after their deadline
+        std::chrono::nanoseconds MaxLateness{0}; // Worst completion time past a deadline
+    };
+
+    // Queue state of one priority lane
+    struct TaskLaneStats {
+        size_t Depth = 0;                       // Tasks queued and not yet started
+        uint64_t Executed = 0;                  // Tasks started
+        std::chrono::nanoseconds AverageWait{0}; // Time from submission to start, over all started tasks
+        std::chrono::nanoseconds MaxWait{0};
+    };
+
+    // Work-stealing pool that executes EventLoop callbacks.
+    // Every worker owns a deque: it pushes and pops its own tasks at the back (LIFO, cache-warm)
+    // while idle workers steal from the front (FIFO, oldest first). Tasks submitted from a worker
+    // go to its own deque. Single tasks from other threads go through a lock-free injection queue
+    // that every worker polls, so producers never block each other or the workers; batches (and
+    // single tasks while the injection queue is full) are spread round-robin over the deques.
+    // Idle workers sleep on a condition variable and are only signalled when one is asleep.
+    // Normal tasks take that path. Critical and Background tasks go to one shared queue per lane,
+    // which workers check before (Critical) and after (Background) the normal lane.
+    // Tasks with a deadline go to a heap per lane instead and run before the other tasks of their
+    // lane, earliest deadline first, so a saturated pool spends its time on the most urgent work.
+    class ThreadPool {
+    public:
+        static constexpr size_t InjectorCapacity = 1024;
+
+        // Workers check the injection queue before their own deque every this many tasks, so
+        // external submissions are not starved by a worker that keeps feeding itself
+        static constexpr uint32_t InjectorPollInterval = 61;
+
+        // Adaptive pools: a worker checks whether the pool should grow every this many tasks, and
+        // after any task that waited GrowWait or longer, so most tasks touch no shared state for it
+        static constexpr uint32_t GrowSampleInterval = 64;
+
+        // Creates no threads until Start(); tasks submitted before that wait for it
+        explicit ThreadPool(const ThreadPoolSpecification& specification);
+
+        // Starts threadCount workers right away (0 = hardware_concurrency(), at least 2)
+        explicit ThreadPool(size_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Launch the initial workers. A pool that was shut down can be started again.
+        void Start();
+
+        void Submit(EventCallback task, TaskPriority priority = TaskPriority::Normal);
+
+        // Submit every task in tasks with one lock per receiving worker (or lane) and clear the vector
+        void Submit(std::vector<EventCallback>& tasks, TaskPriority priority = TaskPriority::Normal);
+
+        // Queue tasks by deadline (one lock for the batch) and clear the vector
+        void Submit(DeadlineTask task, TaskPriority priority = TaskPriority::Normal);
+        void Submit(std::vector<DeadlineTask>& tasks, TaskPriority priority = TaskPriority::Normal);
+
+        // From a worker of this pool: take one queued task and run it, picking it the way the worker
+        // loop does. Lets a task that waits for others help with them. False if nothing was queued
+        // or the caller is not a worker of this pool.
+        bool RunPendingTask();
+
+        // Run the queued tasks, then join the workers. Later submissions wait for the next Start().
+        void Shutdown();
+
+        // Block until ready() returns true. It is checked again whenever a worker takes a task and
+        // when the pool shuts down, so a submitter can wait for the backlog to shrink without polling.
+        template<typename Predicate>
+        void WaitForTaken(Predicate ready) {
+            m_TakenWaiters.fetch_add(1);
+            {
+                std::unique_lock<std::mutex> lock(m_TakenMutex);
+                m_TakenCondition.wait(lock, ready);
+            }
+            m_TakenWaiters.fetch_sub(1);
+        }
+
+        // Workers currently running, and the most the pool will run
+        size_t GetThreadCount() const { return m_ActiveWorkers.load(std::memory_order_acquire); }
+        size_t GetMaxThreadCount() const { return m_Workers.size(); }
+
+        // Index of the calling worker thread in this pool, or -1 for other threads
+        int GetCurrentWorkerIndex() const;
+
+        // Tasks queued and not yet taken by a worker, all lanes
+        size_t GetPendingCount() const { return m_Pending.load(std::memory_order_relaxed); }
+
+        // Workers launched on demand after Start(), and idle workers retired by an adaptive pool
+        uint64_t GetWorkersAdded() const { return m_WorkersAdded.load(std::memory_order_relaxed); }
+        uint64_t GetWorkersRetired() const { return m_WorkersRetired.load(std::memory_order_relaxed); }
+
+        uint64_t GetTasksExecuted() const;
+        uint64_t GetTasksStolen() const;
+        TaskLaneStats GetLaneStats(TaskPriority priority) const;
+        DeadlineStats GetDeadlineStats() const;
+
+    private:
+        struct NativeThread; // Platform thread for workers with a custom stack size
+
+        // A task and when it was submitted, for the lane wait-time statistics
+        struct QueuedTask {
+            EventCallback callback;
+            std::chrono::steady_clock::time_point queued;
+
+            // Deadline tasks only
+            std::chrono::steady_clock::time_point deadline;
+            uint64_t sequence = 0; // Submission order, breaks ties between equal deadlines
+            bool countMiss = false;
+
+            QueuedTask() = default;
+            QueuedTask(EventCallback task, std::chrono::steady_clock::time_point queuedAt)
+                : callback(std::move(task)), queued(queuedAt) {}
+        };
+
+        struct alignas(64) Worker {
+            std::mutex mutex;
+            RingQueue<QueuedTask> tasks;
+            std::thread thread;
+            std::unique_ptr<NativeThread> nativeThread;
+            std::atomic<uint64_t> executed{0};
+            std::atomic<uint64_t> stolen{0};
+            uint32_t tick = 0; // Picks made, drives injector polling and starvation protection; this worker only
+            bool retired = false; // Guarded by mutex: the deque was emptied for good, push elsewhere
+
+            // Adaptive pools only, written by this worker
+            std::atomic<uint64_t> idleTime{0};     // Nanoseconds asleep, finished sleeps only
+            std::atomic<int64_t> sleepingSince{0}; // Steady clock nanoseconds, 0 while awake
+
+            // Per lane, written by this worker only
+            std::atomic<uint64_t> laneExecuted[TaskPriorityCount] = {};
+            std::atomic<uint64_t> laneWait[TaskPriorityCount] = {};    // Nanoseconds
+            std::atomic<uint64_t> laneMaxWait[TaskPriorityCount] = {}; // Nanoseconds
+            std::atomic<uint64_t> deadlineCompleted{0};
+            std::atomic<uint64_t> deadlineMissed{0};
+            std::atomic<uint64_t> maxLateness{0};                      // Nanoseconds
+
+            ~Worker();
+        };
+
+        // Shared queue of the Critical or Background lane
+        struct alignas(64) Lane {
+            std::mutex mutex;
+            RingQueue<QueuedTask> tasks;
+            std::atomic<size_t> depth{0}; // Lets workers skip an empty lane without locking it
+        };
+
+        // Deadline tasks of one lane, a binary min-heap on (deadline, sequence)
+        struct alignas(64) DeadlineLane {
+            std::mutex mutex;
+            std::vector<QueuedTask> heap;
+            uint64_t nextSequence = 0;
+            std::atomic<size_t> depth{0};
+        };
+
+        Lane& GetLane(TaskPriority priority) { return priority == TaskPriority::Critical ? m_Critical : m_Background; }
+        void LaunchWorker(size_t index);
+        void JoinWorker(Worker& worker);
+        void GrowIfBusy(std::chrono::nanoseconds waited = std::chrono::nanoseconds(0));
+        bool TryRetire(size_t index);
+        void StartWindow(size_t workerCount, int64_t now);
+        uint64_t IdleTime(size_t workerCount, int64_t now) const;
+        void WorkerThread(size_t index);
+        bool RunNext(size_t index);
+        void PushDeadline(DeadlineLane& lane, QueuedTask task);
+        bool PopDeadline(TaskPriority priority, QueuedTask& task);
+        bool PopLane(TaskPriority priority, QueuedTask& task);
+        bool PopNormal(size_t index, uint32_t tick, QueuedTask& task);
+        bool PopLocal(Worker& worker, QueuedTask& task);
+        void PushToWorker(size_t index, QueuedTask task);
+        bool Steal(size_t thief, QueuedTask& task);
+        void Run(QueuedTask& task, TaskPriority priority);
+        void WakeWorkers(size_t count);
+        void WakeTakenWaiters(bool all);
+
+    private:
+        ThreadPoolSpecification m_Specification;
+        size_t m_InitialWorkers = 0;
+        std::vector<std::unique_ptr<Worker>> m_Workers; // Sized for the maximum, threads launched on demand
+        std::atomic<size_t> m_ActiveWorkers{0};         // Workers [0, m_ActiveWorkers) have been launched
+        std::mutex m_LaunchMutex;                       // Serializes launching and retiring with Start/Shutdown
+        std::atomic<uint64_t> m_WorkersAdded{0};
+        std::atomic<uint64_t> m_WorkersRetired{0};
+
+        // Adaptive sizing, steady clock nanoseconds
+        std::atomic<int64_t> m_SaturatedSince{0}; // Since when tasks have queued with no idle worker, 0 = an idle worker looked
+        std::atomic<int64_t> m_LastResize{0};
+        int64_t m_WindowStart = 0;                // Idle ratio window, guarded by m_LaunchMutex
+        uint64_t m_WindowIdle = 0;                // IdleTime() when the window started
+
+        MpmcQueue<QueuedTask> m_Injector{InjectorCapacity}; // External single submissions
+        std::atomic<size_t> m_NextWorker{0};    // Round-robin target for external batches
+        Lane m_Critical;
+        Lane m_Background;
+        DeadlineLane m_Deadlines[TaskPriorityCount];
+
+        // Sleep protocol: a submitter increments m_Pending, publishes the task and then checks
+        // m_Sleepers, a worker increments m_Sleepers and then re-checks m_Pending under m_SleepMutex.
+        // Both are sequentially consistent, so at least one side sees the other and no wakeup is
+        // lost. Incrementing before publishing keeps the count from dropping below zero when a
+        // worker takes the task at once; a worker that sees the count first just looks again.
+        std::atomic<size_t> m_Pending{0};       // Tasks queued (or being queued) but not yet taken, all lanes
+        std::atomic<size_t> m_Sleepers{0};
+        std::mutex m_SleepMutex;
+        std::condition_variable m_SleepCondition;
+        std::atomic<bool> m_Stopping{true};     // Until Start()
+
+        // WaitForTaken: a worker decrements m_Pending and then checks m_TakenWaiters, a waiter
+        // increments m_TakenWaiters and then checks its predicate under m_TakenMutex (as above)
+        std::atomic<size_t> m_TakenWaiters{0};
+        std::mutex m_TakenMutex;
+        std::condition_variable m_TakenCondition;
+    };
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
+
+#endif // WALRUS_THREADPOOL_H
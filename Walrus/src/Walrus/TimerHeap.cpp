@@ -0,0 +1,136 @@
+#include "TimerHeap.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+namespace Walrus {
+
+    EventId TimerHeap::Push(TimerEvent event) {
+        uint32_t index = m_Slots.Acquire();
+        event.id = MakeEventId(index, m_Slots.Generation(index), false);
+
+        m_Slots[index].event = std::move(event);
+        Insert(index);
+
+        return m_Slots[index].event.id;
+    }
+
+    bool TimerHeap::Cancel(EventId id) {
+        const uint32_t index = EventIdIndex(id);
+        if (IsImmediateEventId(id) || !m_Slots.Contains(index, EventIdGeneration(id))) {
+            return false;
+        }
+
+        RemoveAt(m_Slots[index].position);
+        m_Slots.Release(index);
+        return true;
+    }
+
+    void TimerHeap::ProcessExpired(TimePoint now, const FireCallback& fire) {
+        while (!m_Heap.empty() && m_Heap.front().deadline <= now) {
+            uint32_t index = m_Heap.front().slot;
+            Slot& slot = m_Slots[index];
+
+            if (!fire(slot.event)) {
+                RemoveAt(0);
+                m_Slots.Release(index);
+                continue;
+            }
+
+            if (slot.event.nextExecution > now) {
+                // Re-armed into the future: only the key of the root grew
+                m_Heap.front().deadline = slot.event.nextExecution;
+                SiftDown(0);
+            } else {
+                // Still due, keep it for the next pass instead of firing it again now
+                RemoveAt(0);
+                m_Deferred.push_back(index);
+            }
+        }
+
+        for (uint32_t index : m_Deferred) {
+            Insert(index);
+        }
+        m_Deferred.clear();
+    }
+
+    TimerQueue::TimePoint TimerHeap::NextDeadline() const {
+        return m_Heap.empty() ? TimePoint::max() : m_Heap.front().deadline;
+    }
+
+    void TimerHeap::Reserve(size_t capacity) {
+        m_Slots.Reserve(capacity);
+        m_Heap.reserve(capacity);
+    }
+
+    void TimerHeap::Insert(uint32_t index) {
+        uint32_t position = static_cast<uint32_t>(m_Heap.size());
+        m_Heap.push_back({ m_Slots[index].event.nextExecution, index });
+        m_Slots[index].position = position;
+        SiftUp(position);
+    }
+
+    void TimerHeap::RemoveAt(uint32_t position) {
+        uint32_t last = static_cast<uint32_t>(m_Heap.size() - 1);
+        m_Slots[m_Heap[position].slot].position = InvalidIndex;
+
+        if (position != last) {
+            HeapEntry moved = m_Heap[last];
+            m_Heap.pop_back();
+            Place(position, moved);
+
+            // The moved entry may belong above or below its new position
+            if (position > 0 && moved.deadline < m_Heap[(position - 1) / 2].deadline) {
+                SiftUp(position);
+            } else {
+                SiftDown(position);
+            }
+        } else {
+            m_Heap.pop_back();
+        }
+    }
+
+    void TimerHeap::SiftUp(uint32_t position) {
+        HeapEntry entry = m_Heap[position];
+
+        while (position > 0) {
+            uint32_t parent = (position - 1) / 2;
+            if (!(entry.deadline < m_Heap[parent].deadline)) {
+                break;
+            }
+            Place(position, m_Heap[parent]);
+            position = parent;
+        }
+
+        Place(position, entry);
+    }
+
+    void TimerHeap::SiftDown(uint32_t position) {
+        const uint32_t size = static_cast<uint32_t>(m_Heap.size());
+        HeapEntry entry = m_Heap[position];
+
+        while (true) {
+            uint32_t child = position * 2 + 1;
+            if (child >= size) {
+                break;
+            }
+            if (child + 1 < size && m_Heap[child + 1].deadline < m_Heap[child].deadline) {
+                ++child;
+            }
+            if (!(m_Heap[child].deadline < entry.deadline)) {
+                break;
+            }
+            Place(position, m_Heap[child]);
+            position = child;
+        }
+
+        Place(position, entry);
+    }
+
+    void TimerHeap::Place(uint32_t position, const HeapEntry& entry) {
+        m_Heap[position] = entry;
+        m_Slots[entry.slot].position = position;
+    }
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
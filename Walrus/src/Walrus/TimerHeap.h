@@ -0,0 +1,59 @@
+#ifndef WALRUS_TIMERHEAP_H
+#define WALRUS_TIMERHEAP_H
+
+#include "TimerQueue.h"
+#include "Slab.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include <vector>
+
+namespace Walrus {
+
+    // Indexed binary min-heap of timers ordered by nextExecution.
+    // Every timer knows its heap position, so Cancel removes it in O(log n) and releases
+    // its callback immediately instead of leaving a tombstone behind until the deadline.
+    class TimerHeap : public TimerQueue {
+    public:
+        TimerHeap() = default;
+
+        EventId Push(TimerEvent event) override;
+        bool Cancel(EventId id) override;
+        void ProcessExpired(TimePoint now, const FireCallback& fire) override;
+        TimePoint NextDeadline() const override;
+        size_t Size() const override { return m_Heap.size(); }
+        void Reserve(size_t capacity) override;
+        size_t HighWater() const override { return m_Slots.HighWater(); }
+
+    private:
+        static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+        struct Slot {
+            TimerEvent event;
+            uint32_t position = InvalidIndex; // Index in m_Heap
+        };
+
+        // Deadlines are kept next to the slot index so sifting does not touch the slots
+        struct HeapEntry {
+            TimePoint deadline;
+            uint32_t slot;
+        };
+
+        void Insert(uint32_t index);
+        void RemoveAt(uint32_t position);
+        void SiftUp(uint32_t position);
+        void SiftDown(uint32_t position);
+        void Place(uint32_t position, const HeapEntry& entry);
+
+    private:
+        Slab<Slot> m_Slots;
+
+        std::vector<HeapEntry> m_Heap;
+        std::vector<uint32_t> m_Deferred; // Re-armed timers that are already due again
+    };
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
+
+#endif // WALRUS_TIMERHEAP_H
@@ -0,0 +1,133 @@
+#ifndef WALRUS_TIMERQUEUE_H
+#define WALRUS_TIMERQUEUE_H
+
+#include "Config.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include "UniqueFunction.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Walrus {
+
+    using EventCallback = UniqueFunction<void()>;
+    using EventId = uint64_t;
+
+    // EventIds are generational handles into the record slab that owns the event:
+    // bit 63 = immediate flag, bits 32..62 = slab generation (never 0), bits 0..31 = slab index.
+    // Cancelling is an array access, and handles of completed events never match a reused record.
+    constexpr EventId ImmediateEventIdFlag = EventId(1) << 63;
+
+    inline EventId MakeEventId(uint32_t index, uint32_t generation, bool immediate) {
+        return (immediate ? ImmediateEventIdFlag : 0) | (EventId(generation) << 32) | index;
+    }
+    inline uint32_t EventIdIndex(EventId id) { return static_cast<uint32_t>(id); }
+    inline uint32_t EventIdGeneration(EventId id) { return static_cast<uint32_t>((id & ~ImmediateEventIdFlag) >> 32); }
+    inline bool IsImmediateEventId(EventId id) { return (id & ImmediateEventIdFlag) != 0; }
+
+    // Interval callback that receives the number of ticks folded into this call
+    using IntervalCallback = UniqueFunction<void(uint64_t missedTicks)>;
+
+    // How SetInterval schedules its next tick
+    enum class IntervalPolicy {
+        Relative,   // Next tick = time the tick was processed + interval (drifts with loop latency)
+        Skip,       // Anchored to the original schedule, ticks missed under load are dropped
+        CatchUp,    // Anchored, every missed tick is delivered in a burst
+        Coalesce    // Anchored, missed ticks are folded into one call that receives their count
+    };
+
+    // Thread pool lane a callback is queued in. Workers take Critical tasks first and Background
+    // tasks last, see ThreadPoolSpecification::StarvationLimit for how lower lanes still progress.
+    enum class TaskPriority : uint8_t {
+        Critical,   // Latency-sensitive work such as heartbeats and input handling
+        Normal,
+        Background  // Bulk work that may wait behind everything else
+    };
+
+    constexpr size_t TaskPriorityCount = 3;
+    inline size_t TaskLane(TaskPriority priority) { return static_cast<size_t>(priority); }
+
+    // Callback of an interval, shared by the timer and every tick it dispatched
+    struct IntervalState {
+        IntervalCallback callback;
+
+        // Non-overlapping intervals only: whether a tick is running (and one more is pending), and
+        // the ticks missed or dropped since the last call, reported to it under IntervalPolicy::Coalesce
+        bool nonOverlapping = false;
+        bool reportMissed = false;
+        std::atomic<uint32_t> phase{0};
+        std::atomic<uint64_t> folded{0};
+
+        explicit IntervalState(IntervalCallback cb) : callback(std::move(cb)) {}
+    };
+
+    struct TimerEvent {
+        EventId id = 0;
+        EventCallback callback;                          // Timeouts: handed over to the thread pool when fired
+        std::shared_ptr<IntervalState> intervalState;    // Intervals: shared by every dispatched tick, so firing never copies captures
+        std::chrono::steady_clock::time_point nextExecution;
+        std::chrono::steady_clock::time_point scheduled; // Nominal deadline before tolerance alignment
+        std::chrono::nanoseconds interval{0};
+        std::chrono::nanoseconds tolerance{0}; // Allowed lateness, used to coalesce nearby expirations
+        IntervalPolicy policy = IntervalPolicy::Relative;
+        uint32_t maxCatchUpCalls = 1;          // Burst limit of a late IntervalPolicy::CatchUp tick
+        TaskPriority priority = TaskPriority::Normal;
+        std::chrono::nanoseconds deadline{0};  // Completion budget after each due time, 0 = none
+        bool repeat = false;
+
+        TimerEvent() = default;
+        TimerEvent(EventId id, EventCallback cb, std::chrono::steady_clock::time_point next,
+                  std::chrono::nanoseconds interval = std::chrono::nanoseconds(0), bool repeat = false)
+            : id(id), callback(std::move(cb)), nextExecution(next), scheduled(next), interval(interval), repeat(repeat) {}
+    };
+
+    enum class TimerBackend {
+        Heap = WALRUS_TIMER_BACKEND_HEAP,
+        Wheel = WALRUS_TIMER_BACKEND_WHEEL
+    };
+
+    // Storage for pending timers, ordered by TimerEvent::nextExecution.
+    // Implementations are not thread-safe; EventLoop serializes access with its timer mutex.
+    class TimerQueue {
+    public:
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        // Called for every expired timer. Return true to re-arm the timer at its
+        // (possibly updated) nextExecution, false to release it.
+        using FireCallback = UniqueFunction<bool(TimerEvent&)>;
+
+        virtual ~TimerQueue() = default;
+
+        // Store a timer, assigning and returning its EventId (the event's id is overwritten)
+        virtual EventId Push(TimerEvent event) = 0;
+
+        // Remove a pending timer, returns false if the id is stale or unknown
+        virtual bool Cancel(EventId id) = 0;
+
+        // Fire every timer whose nextExecution is at or before now
+        virtual void ProcessExpired(TimePoint now, const FireCallback& fire) = 0;
+
+        // Earliest point in time at which ProcessExpired may have work, TimePoint::max() when empty
+        virtual TimePoint NextDeadline() const = 0;
+
+        // Number of entries held by the queue
+        virtual size_t Size() const = 0;
+        bool Empty() const { return Size() == 0; }
+
+        // Preallocate room for capacity timers so scheduling up to that many does not allocate
+        virtual void Reserve(size_t capacity) = 0;
+
+        // Most timers held at the same time since construction
+        virtual size_t HighWater() const = 0;
+    };
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
+
+#endif // WALRUS_TIMERQUEUE_H
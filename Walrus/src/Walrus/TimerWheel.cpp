@@ -0,0 +1,266 @@
+#include "TimerWheel.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Walrus {
+
+    namespace {
+
+        inline uint32_t CountTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward64(&index, value);
+            return static_cast<uint32_t>(index);
+#else
+            return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+        }
+
+    } // namespace
+
+    TimerWheel::TimerWheel(std::chrono::nanoseconds tick, TimePoint origin)
+        : m_Tick(std::max(tick, std::chrono::nanoseconds(1))), m_Origin(origin)
+    {
+        m_Buckets.fill(InvalidIndex);
+    }
+
+    EventId TimerWheel::Push(TimerEvent event) {
+        uint32_t index = m_Slots.Acquire();
+        event.id = MakeEventId(index, m_Slots.Generation(index), false);
+
+        Slot& slot = m_Slots[index];
+        slot.tick = CeilTick(event.nextExecution);
+        slot.event = std::move(event);
+        Link(index);
+
+        return m_Slots[index].event.id;
+    }
+
+    bool TimerWheel::Cancel(EventId id) {
+        const uint32_t index = EventIdIndex(id);
+        if (IsImmediateEventId(id) || !m_Slots.Contains(index, EventIdGeneration(id))) {
+            return false;
+        }
+
+        Unlink(index);
+        m_Slots.Release(index);
+        return true;
+    }
+
+    void TimerWheel::ProcessExpired(TimePoint now, const FireCallback& fire) {
+        ExpireBucket(OverdueBucket, fire);
+
+        const uint64_t target = FloorTick(now);
+        while (m_CurrentTick < target) {
+            // Jump straight to the next tick that expires or cascades something
+            uint64_t next = NextEventTick();
+            if (next > target) {
+                m_CurrentTick = target;
+                break;
+            }
+
+            m_CurrentTick = next;
+
+            // Higher levels first so their timers can land in the buckets cascaded below
+            for (uint32_t level = LevelCount - 1; level > 0; --level) {
+                const uint32_t shift = SlotBits * level;
+                if ((m_CurrentTick & ((uint64_t(1) << shift) - 1)) == 0) {
+                    CascadeBucket(level * SlotsPerLevel + static_cast<uint32_t>((m_CurrentTick >> shift) & SlotMask));
+                }
+            }
+
+            // Cascaded timers due exactly at this tick were linked as overdue
+            ExpireBucket(OverdueBucket, fire);
+            ExpireBucket(static_cast<uint32_t>(m_CurrentTick & SlotMask), fire);
+        }
+    }
+
+    TimerQueue::TimePoint TimerWheel::NextDeadline() const {
+        if (m_Buckets[OverdueBucket] != InvalidIndex) {
+            return m_Origin + m_Tick * m_CurrentTick;
+        }
+
+        uint64_t next = NextEventTick();
+        if (next == NoTick) {
+            return TimePoint::max();
+        }
+
+        // For higher levels this is the cascade point, which never lies after the real deadline
+        return m_Origin + m_Tick * next;
+    }
+
+    void TimerWheel::Reserve(size_t capacity) {
+        m_Slots.Reserve(capacity);
+    }
+
+    void TimerWheel::Link(uint32_t index) {
+        Slot& slot = m_Slots[index];
+
+        uint32_t bucket = OverdueBucket;
+        if (slot.tick > m_CurrentTick) {
+            const uint64_t delta = slot.tick - m_CurrentTick;
+
+            uint32_t level = 0;
+            while (level < LevelCount - 1 && delta >= (uint64_t(1) << (SlotBits * (level + 1)))) {
+                ++level;
+            }
+
+            // Beyond the wheel's span: park in the farthest top-level bucket and re-cascade later
+            uint64_t tick = slot.tick;
+            const uint64_t span = uint64_t(1) << (SlotBits * LevelCount);
+            if (delta >= span) {
+                tick = m_CurrentTick + span - 1;
+            }
+
+            bucket = level * SlotsPerLevel + static_cast<uint32_t>((tick >> (SlotBits * level)) & SlotMask);
+        }
+
+        slot.bucket = bucket;
+        slot.prev = InvalidIndex;
+        slot.next = m_Buckets[bucket];
+        if (slot.next != InvalidIndex) {
+            m_Slots[slot.next].prev = index;
+        }
+        m_Buckets[bucket] = index;
+
+        if (bucket < BucketCount) {
+            m_Occupied[bucket / 64] |= uint64_t(1) << (bucket % 64);
+        }
+    }
+
+    void TimerWheel::Unlink(uint32_t index) {
+        Slot& slot = m_Slots[index];
+        const uint32_t bucket = slot.bucket;
+        if (bucket == InvalidIndex) {
+            return;
+        }
+
+        if (slot.prev != InvalidIndex) {
+            m_Slots[slot.prev].next = slot.next;
+        } else {
+            m_Buckets[bucket] = slot.next;
+        }
+        if (slot.next != InvalidIndex) {
+            m_Slots[slot.next].prev = slot.prev;
+        }
+
+        if (m_Buckets[bucket] == InvalidIndex && bucket < BucketCount) {
+            m_Occupied[bucket / 64] &= ~(uint64_t(1) << (bucket % 64));
+        }
+
+        slot.bucket = InvalidIndex;
+        slot.prev = InvalidIndex;
+        slot.next = InvalidIndex;
+    }
+
+    uint32_t TimerWheel::DetachBucket(uint32_t bucket) {
+        uint32_t head = m_Buckets[bucket];
+        m_Buckets[bucket] = InvalidIndex;
+
+        if (bucket < BucketCount) {
+            m_Occupied[bucket / 64] &= ~(uint64_t(1) << (bucket % 64));
+        }
+        return head;
+    }
+
+    void TimerWheel::ExpireBucket(uint32_t bucket, const FireCallback& fire) {
+        // Detach first so timers re-armed by fire() never show up in this pass again
+        uint32_t index = DetachBucket(bucket);
+
+        while (index != InvalidIndex) {
+            Slot& slot = m_Slots[index];
+            uint32_t next = slot.next;
+            slot.bucket = InvalidIndex;
+
+            if (fire(slot.event)) {
+                slot.tick = CeilTick(slot.event.nextExecution);
+                Link(index);
+            } else {
+                m_Slots.Release(index);
+            }
+
+            index = next;
+        }
+    }
+
+    void TimerWheel::CascadeBucket(uint32_t bucket) {
+        uint32_t index = DetachBucket(bucket);
+
+        while (index != InvalidIndex) {
+            uint32_t next = m_Slots[index].next;
+            Link(index);
+            index = next;
+        }
+    }
+
+    uint64_t TimerWheel::CeilTick(TimePoint time) const {
+        if (time <= m_Origin) {
+            return 0;
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_Origin).count();
+        return static_cast<uint64_t>((elapsed + m_Tick.count() - 1) / m_Tick.count());
+    }
+
+    uint64_t TimerWheel::FloorTick(TimePoint time) const {
+        if (time <= m_Origin) {
+            return 0;
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_Origin).count();
+        return static_cast<uint64_t>(elapsed / m_Tick.count());
+    }
+
+    uint64_t TimerWheel::NextEventTick() const {
+        if (m_Slots.Size() == 0) {
+            return NoTick;
+        }
+
+        uint64_t best = NoTick;
+
+        // Level 0: the next occupied bucket expires at its own tick
+        uint32_t distance = FindOccupied(0, static_cast<uint32_t>(m_CurrentTick & SlotMask));
+        if (distance != 0) {
+            best = m_CurrentTick + distance;
+        }
+
+        // Higher levels: the next occupied bucket is cascaded when the lower bits wrap to it
+        for (uint32_t level = 1; level < LevelCount; ++level) {
+            const uint32_t shift = SlotBits * level;
+            const uint64_t period = m_CurrentTick >> shift;
+
+            distance = FindOccupied(level, static_cast<uint32_t>(period & SlotMask));
+            if (distance != 0) {
+                best = std::min(best, (period + distance) << shift);
+            }
+        }
+
+        return best;
+    }
+
+    uint32_t TimerWheel::FindOccupied(uint32_t level, uint32_t start) const {
+        // Distance (1..SlotsPerLevel) from bucket start to the next occupied bucket, 0 if none
+        const uint64_t* words = &m_Occupied[level * (SlotsPerLevel / 64)];
+        const uint32_t first = (start + 1) & SlotMask;
+
+        for (uint32_t scanned = 0; scanned < SlotsPerLevel;) {
+            const uint32_t position = (first + scanned) & SlotMask;
+            const uint64_t bits = words[position / 64] >> (position % 64);
+            if (bits != 0) {
+                return scanned + CountTrailingZeros(bits) + 1;
+            }
+            scanned += 64 - (position % 64);
+        }
+
+        return 0;
+    }
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
@@ -0,0 +1,77 @@
+#ifndef WALRUS_TIMERWHEEL_H
+#define WALRUS_TIMERWHEEL_H
+
+#include "TimerQueue.h"
+#include "Slab.h"
+
+#if WALRUS_ENABLE_EVENT_LOOP
+
+#include <array>
+#include <vector>
+
+namespace Walrus {
+
+    // Hierarchical timing wheel (Varghese & Lauck).
+    // Four levels of 256 buckets cover 2^32 ticks; timers further out are parked in the
+    // last level and re-cascaded. Timers live in a flat slot array linked into buckets by
+    // index, so insert, cancel and expiry are O(1) and freed slots are recycled.
+    class TimerWheel : public TimerQueue {
+    public:
+        explicit TimerWheel(std::chrono::nanoseconds tick = std::chrono::microseconds(WALRUS_EVENT_LOOP_TIMER_WHEEL_TICK_US),
+                            TimePoint origin = std::chrono::steady_clock::now());
+
+        EventId Push(TimerEvent event) override;
+        bool Cancel(EventId id) override;
+        void ProcessExpired(TimePoint now, const FireCallback& fire) override;
+        TimePoint NextDeadline() const override;
+        size_t Size() const override { return m_Slots.Size(); }
+        void Reserve(size_t capacity) override;
+        size_t HighWater() const override { return m_Slots.HighWater(); }
+
+        std::chrono::nanoseconds GetTickDuration() const { return m_Tick; }
+
+    private:
+        static constexpr uint32_t SlotBits = 8;
+        static constexpr uint32_t SlotsPerLevel = 1u << SlotBits;
+        static constexpr uint32_t SlotMask = SlotsPerLevel - 1;
+        static constexpr uint32_t LevelCount = 4;
+        static constexpr uint32_t BucketCount = LevelCount * SlotsPerLevel;
+        static constexpr uint32_t OverdueBucket = BucketCount; // Timers already due when linked
+        static constexpr uint32_t InvalidIndex = UINT32_MAX;
+        static constexpr uint64_t NoTick = UINT64_MAX;
+
+        struct Slot {
+            TimerEvent event;
+            uint64_t tick = 0;
+            uint32_t bucket = InvalidIndex;
+            uint32_t prev = InvalidIndex;
+            uint32_t next = InvalidIndex;
+        };
+
+        void Link(uint32_t index);
+        void Unlink(uint32_t index);
+        uint32_t DetachBucket(uint32_t bucket);
+        void ExpireBucket(uint32_t bucket, const FireCallback& fire);
+        void CascadeBucket(uint32_t bucket);
+
+        uint64_t CeilTick(TimePoint time) const;
+        uint64_t FloorTick(TimePoint time) const;
+        uint64_t NextEventTick() const;
+        uint32_t FindOccupied(uint32_t level, uint32_t start) const;
+
+    private:
+        std::chrono::nanoseconds m_Tick;
+        TimePoint m_Origin;
+        uint64_t m_CurrentTick = 0; // Every tick up to and including this one has been processed
+
+        Slab<Slot> m_Slots;
+
+        std::array<uint32_t, BucketCount + 1> m_Buckets;
+        std::array<uint64_t, BucketCount / 64> m_Occupied{};
+    };
+
+} // namespace Walrus
+
+#endif // WALRUS_ENABLE_EVENT_LOOP
+
+#endif // WALRUS_TIMERWHEEL_H
@@ -0,0 +1,175 @@
+#ifndef WALRUS_UNIQUEFUNCTION_H
+#define WALRUS_UNIQUEFUNCTION_H
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Walrus {
+
+    template<typename Signature>
+    class UniqueFunction;
+
+    // Move-only replacement for std::function with a 56 byte inline buffer.
+    // Callables that fit (and are nothrow-movable) are stored in place, so lambdas capturing a few
+    // pointers, a shared_ptr or a std::function never touch the heap. Larger ones are boxed once
+    // on construction; moving a UniqueFunction never allocates.
+    template<typename R, typename... Args>
+    class UniqueFunction<R(Args...)> {
+    public:
+        static constexpr size_t InlineSize = 64 - sizeof(void*);
+
+        template<typename F>
+        static constexpr bool IsStoredInline = sizeof(F) <= InlineSize
+            && alignof(F) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible<F>::value;
+
+        UniqueFunction() noexcept = default;
+        UniqueFunction(std::nullptr_t) noexcept {}
+
+        template<typename F, typename Functor = std::decay_t<F>,
+                 typename = std::enable_if_t<!std::is_same<Functor, UniqueFunction>::value
+                                             && std::is_invocable_r<R, Functor&, Args...>::value>>
+        UniqueFunction(F&& function) {
+            if (IsNull(function)) {
+                return;
+            }
+
+            if constexpr (IsStoredInline<Functor>) {
+                ::new (static_cast<void*>(m_Storage)) Functor(std::forward<F>(function));
+            } else {
+                ::new (static_cast<void*>(m_Storage)) Functor*(new Functor(std::forward<F>(function)));
+            }
+            m_Operations = &OperationsFor<Functor>::Table;
+        }
+
+        UniqueFunction(UniqueFunction&& other) noexcept {
+            MoveFrom(other);
+        }
+
+        UniqueFunction& operator=(UniqueFunction&& other) noexcept {
+            if (this != &other) {
+                Reset();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+
+        UniqueFunction& operator=(std::nullptr_t) noexcept {
+            Reset();
+            return *this;
+        }
+
+        template<typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, UniqueFunction>::value>>
+        UniqueFunction& operator=(F&& function) {
+            return *this = UniqueFunction(std::forward<F>(function));
+        }
+
+        UniqueFunction(const UniqueFunction&) = delete;
+        UniqueFunction& operator=(const UniqueFunction&) = delete;
+
+        ~UniqueFunction() { Reset(); }
+
+        // Like std::function, calling is const but the target itself may be mutable
+        R operator()(Args... args) const {
+            if (!m_Operations) {
+                throw std::bad_function_call();
+            }
+            return m_Operations->Invoke(const_cast<unsigned char*>(m_Storage), std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const noexcept { return m_Operations != nullptr; }
+
+        // True when the target lives in the inline buffer (or there is no target)
+        bool IsInline() const noexcept { return !m_Operations || m_Operations->Inline; }
+
+        friend bool operator==(const UniqueFunction& function, std::nullptr_t) noexcept { return !function; }
+        friend bool operator!=(const UniqueFunction& function, std::nullptr_t) noexcept { return static_cast<bool>(function); }
+
+    private:
+        struct Operations {
+            R (*Invoke)(void* storage, Args&&... args);
+            void (*Move)(void* destination, void* source) noexcept; // Leaves source destroyed
+            void (*Destroy)(void* storage) noexcept;
+            bool Inline;
+        };
+
+        template<typename F>
+        struct OperationsFor {
+            static F& Target(void* storage) {
+                if constexpr (IsStoredInline<F>) {
+                    return *std::launder(static_cast<F*>(storage));
+                } else {
+                    return **std::launder(static_cast<F**>(storage));
+                }
+            }
+
+            static R Invoke(void* storage, Args&&... args) {
+                if constexpr (std::is_void<R>::value) {
+                    std::invoke(Target(storage), std::forward<Args>(args)...);
+                } else {
+                    return std::invoke(Target(storage), std::forward<Args>(args)...);
+                }
+            }
+
+            static void Move(void* destination, void* source) noexcept {
+                if constexpr (IsStoredInline<F>) {
+                    F& target = Target(source);
+                    ::new (destination) F(std::move(target));
+                    target.~F();
+                } else {
+                    ::new (destination) F*(*static_cast<F**>(source));
+                }
+            }
+
+            static void Destroy(void* storage) noexcept {
+                if constexpr (IsStoredInline<F>) {
+                    Target(storage).~F();
+                } else {
+                    delete &Target(storage);
+                }
+            }
+
+            static constexpr Operations Table{ &Invoke, &Move, &Destroy, IsStoredInline<F> };
+        };
+
+        template<typename F>
+        static bool IsNull(const F& function) {
+            if constexpr (std::is_pointer<F>::value || std::is_member_pointer<F>::value) {
+                return function == nullptr;
+            } else {
+                return IsEmptyStdFunction(function);
+            }
+        }
+
+        template<typename Signature>
+        static bool IsEmptyStdFunction(const std::function<Signature>& function) { return !function; }
+        template<typename F>
+        static bool IsEmptyStdFunction(const F&) { return false; }
+
+        void MoveFrom(UniqueFunction& other) noexcept {
+            if (other.m_Operations) {
+                other.m_Operations->Move(m_Storage, other.m_Storage);
+                m_Operations = other.m_Operations;
+                other.m_Operations = nullptr;
+            }
+        }
+
+        void Reset() noexcept {
+            if (m_Operations) {
+                const Operations* operations = m_Operations;
+                m_Operations = nullptr;
+                operations->Destroy(m_Storage);
+            }
+        }
+
+    private:
+        alignas(std::max_align_t) unsigned char m_Storage[InlineSize];
+        const Operations* m_Operations = nullptr;
+    };
+
+} // namespace Walrus
+
+#endif // WALRUS_UNIQUEFUNCTION_H
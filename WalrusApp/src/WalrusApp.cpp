@@ -1,3 +1,8 @@
+// Strand is compiled into the library only when it is built with the EventLoop, so look at that
+// setting before the demo turns the EventLoop on for its own code
+#if WALRUS_ENABLE_EVENT_LOOP
+#define WALRUS_APP_USE_STRAND 1
+#endif
 #define WALRUS_ENABLE_EVENT_LOOP 1
 #define WALRUS_ENABLE_PUBSUB 1
 #include "Walrus/Application.h"
@@ -5,6 +10,9 @@
 #include "Walrus/Config.h"
 
 #include "Walrus/EventLoop.h"
+#if WALRUS_APP_USE_STRAND
+#include "Walrus/Strand.h"
+#endif
 
 #include "Walrus/PubSub.h"
 #include "Walrus/InMemoryBroker.h"
@@ -27,7 +35,12 @@ class ObjectA : public Walrus::Layer
 {
 private:
     Walrus::EventId m_IntervalId = 0;
+#if WALRUS_APP_USE_STRAND
+    int m_Counter = 0; // Only touched on m_Strand, so no lock is needed
+    Walrus::Strand m_Strand{ Walrus::Application::Get().GetEventLoop() };
+#else
     int m_Counter = 0;
+#endif
 
 public:
     virtual void OnAttach() override
@@ -39,7 +52,7 @@ public:
         std::cout << "Starting interval to send data every 1000ms..." << std::endl;
         
         // Set up interval to send data packets every 1000ms
-        m_IntervalId = app.SetInterval([this, &app]() {
+        auto tick = [this, &app]() {
             m_Counter++;
             
             // Create and send data packet
@@ -61,7 +74,14 @@ public:
                     app.Close();
                 }, 2000);
             }
-        }, 1000);
+        };
+
+#if WALRUS_APP_USE_STRAND
+        // Ticks run on the layer's strand: in order and never on two workers at once
+        m_IntervalId = app.SetInterval(m_Strand.Wrap(std::move(tick)), 1000);
+#else
+        m_IntervalId = app.SetInterval(std::move(tick), 1000);
+#endif
     }
     
     virtual void OnDetach() override